@@ -0,0 +1,350 @@
+#include "AssetLoader.h"
+#include "ResourcePack.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+static const char* TypeName(AssetType type) {
+    switch (type) {
+        case AssetType::TEXTURE: return "texture";
+        case AssetType::SOUND: return "sound";
+        case AssetType::MUSIC: return "music";
+    }
+    return "asset";
+}
+
+std::string ResourcePath(const std::string& relative) {
+    static const std::string root = [] {
+        std::string besideExecutable = std::string(GetApplicationDirectory()) + "resources";
+        if (DirectoryExists(besideExecutable.c_str())) {
+            return besideExecutable + "/";
+        }
+        return std::string("resources/");
+    }();
+    return root + relative;
+}
+
+static void OpenGamePack() {
+    ResourcePack& pack = ResourcePack::Instance();
+    std::string besideExecutable = std::string(GetApplicationDirectory()) + "resources.pak";
+    const char* candidates[] = {besideExecutable.c_str(), "resources.pak"};
+    for (const char* file : candidates) {
+        if (!FileExists(file)) {
+            continue;
+        }
+        if (pack.Open(file)) {
+            TraceLog(LOG_INFO, "ASSETS: Mapped %s (%d files)", file, pack.GetEntryCount());
+            return;
+        }
+        TraceLog(LOG_WARNING, "ASSETS: %s is not a valid resource pack", file);
+    }
+}
+
+std::string CookedResourceName(const std::string& relative) {
+    // Must agree with the cook rules in CMakeLists.txt
+    const char* extension = GetFileExtension(relative.c_str());
+    if (!extension) {
+        return std::string();
+    }
+    std::string stem = relative.substr(0, relative.size() - strlen(extension));
+    if (IsFileExtension(relative.c_str(), ".png;.jpg;.bmp;.tga")) {
+        return stem + ".qoi";
+    }
+    if (IsFileExtension(relative.c_str(), ".mp3;.ogg;.flac")) {
+        return stem + ".qoa";
+    }
+    return std::string();
+}
+
+bool FindPackedResource(const std::string& relative, const unsigned char** data, int* size) {
+    static const bool opened = (OpenGamePack(), true);
+    (void)opened;
+
+    size_t dataSize = 0;
+    if (!ResourcePack::Instance().Find(relative, data, &dataSize)) {
+        return false;
+    }
+    *size = static_cast<int>(dataSize);
+    return true;
+}
+
+AssetLoader::AssetLoader(int workerCount) {
+    for (int i = 0; i < workerCount; i++) {
+        workers.emplace_back(&AssetLoader::WorkerLoop, this);
+    }
+}
+
+AssetLoader::~AssetLoader() {
+    Unload();
+}
+
+void AssetLoader::StopWorkers() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+        queue.clear();
+    }
+    queueReady.notify_all();
+    for (std::thread& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+void AssetLoader::WorkerLoop() {
+    while (true) {
+        Entry* entry = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueReady.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (stopping) {
+                return;
+            }
+            entry = queue.front();
+            queue.pop_front();
+        }
+
+        Decode(entry);
+        decoded.Push(entry);
+    }
+}
+
+void AssetLoader::Decode(Entry* entry) {
+    // Nothing here touches the GL context. Music streams register with the
+    // audio device, which raylib guards with its own lock.
+    //
+    // Packed assets are decoded straight out of the mapping; music streams
+    // keep reading from it, which is fine as it outlives the loader.
+    const char* fileType = entry->fileType.c_str();
+    switch (entry->type) {
+        case AssetType::TEXTURE:
+            entry->image = entry->packed
+                ? LoadImageFromMemory(fileType, entry->packed, entry->packedSize)
+                : LoadImage(entry->file.c_str());
+            entry->decodeFailed = (entry->image.data == nullptr);
+            break;
+        case AssetType::SOUND:
+            entry->wave = entry->packed
+                ? LoadWaveFromMemory(fileType, entry->packed, entry->packedSize)
+                : LoadWave(entry->file.c_str());
+            entry->decodeFailed = (entry->wave.data == nullptr);
+            break;
+        case AssetType::MUSIC:
+            entry->music = entry->packed
+                ? LoadMusicStreamFromMemory(fileType, entry->packed, entry->packedSize)
+                : LoadMusicStream(entry->file.c_str());
+            entry->decodeFailed = !IsMusicValid(entry->music);
+            break;
+    }
+}
+
+void AssetLoader::Request(AssetType type, const std::string& path) {
+    if (stopping) {
+        return;
+    }
+    auto it = entries.find(path);
+    if (it != entries.end()) {
+        it->second->released = false;
+        return;
+    }
+
+    auto entry = std::make_unique<Entry>();
+    entry->type = type;
+    entry->path = path;
+    // The cooker only keeps a variant that decodes faster, so a packed one wins
+    std::string cooked = CookedResourceName(path);
+    if (!cooked.empty() && FindPackedResource(cooked, &entry->packed, &entry->packedSize)) {
+        entry->file = "resources.pak:" + cooked;
+    } else if (FindPackedResource(path, &entry->packed, &entry->packedSize)) {
+        entry->file = "resources.pak:" + path;
+    } else {
+        entry->file = ResourcePath(path);
+    }
+    entry->fileType = GetFileExtension(entry->file.c_str());
+    entry->requestTime = GetTime();
+
+    Entry* queued = entry.get();
+    entries[path] = std::move(entry);
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        queue.push_back(queued);
+    }
+    queueReady.notify_one();
+}
+
+void AssetLoader::Poll() {
+    Upload(TEXTURE_UPLOADS_PER_FRAME);
+}
+
+void AssetLoader::Upload(int textureBudget) {
+    Entry* entry = nullptr;
+    while (decoded.Pop(entry)) {
+        entry->state = State::DECODED;
+        uploads.push_back(entry);
+    }
+
+    // Large images are uploaded a few per frame so a burst of decodes
+    // does not turn into one long frame
+    for (auto it = uploads.begin(); it != uploads.end();) {
+        entry = *it;
+        if (entry->released) {
+            Discard(entry);
+            it = uploads.erase(it);
+            std::string path = entry->path;
+            entries.erase(path);
+            continue;
+        }
+        if (entry->type == AssetType::TEXTURE && !entry->decodeFailed) {
+            if (textureBudget <= 0) {
+                ++it;
+                continue;
+            }
+            textureBudget--;
+        }
+        Finish(entry);
+        it = uploads.erase(it);
+    }
+}
+
+void AssetLoader::Discard(Entry* entry) {
+    // Decoded data that was never uploaded
+    if (entry->image.data) UnloadImage(entry->image);
+    if (entry->wave.data) UnloadWave(entry->wave);
+    if (entry->type == AssetType::MUSIC && !entry->decodeFailed) UnloadMusicStream(entry->music);
+    entry->image = Image{0};
+    entry->wave = Wave{0};
+}
+
+void AssetLoader::UnloadLoadedSound(Sound& sound) {
+    if (soundUnloadHandler) {
+        soundUnloadHandler(sound);
+    }
+    UnloadSound(sound);
+}
+
+void AssetLoader::Release(const std::string& path) {
+    auto it = entries.find(path);
+    if (it == entries.end()) {
+        return;
+    }
+
+    Entry* entry = it->second.get();
+    switch (entry->state) {
+        case State::QUEUED: {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            auto queued = std::find(queue.begin(), queue.end(), entry);
+            if (queued == queue.end()) {
+                // On a worker right now; dropped when it comes back
+                entry->released = true;
+                return;
+            }
+            queue.erase(queued);
+            break;
+        }
+        case State::DECODED:
+            entry->released = true;
+            return;
+        case State::READY:
+            switch (entry->type) {
+                case AssetType::TEXTURE: UnloadTexture(entry->texture); break;
+                case AssetType::SOUND: UnloadLoadedSound(entry->sound); break;
+                case AssetType::MUSIC: UnloadMusicStream(entry->music); break;
+            }
+            break;
+        case State::FAILED:
+            break;
+    }
+    entries.erase(it);
+}
+
+void AssetLoader::Finish(Entry* entry) {
+    if (entry->decodeFailed) {
+        TraceLog(LOG_ERROR, "Failed to load %s: %s", TypeName(entry->type), entry->file.c_str());
+        entry->state = State::FAILED;
+        return;
+    }
+
+    switch (entry->type) {
+        case AssetType::TEXTURE:
+            entry->texture = LoadTextureFromImage(entry->image);
+            UnloadImage(entry->image);
+            entry->image = Image{0};
+            break;
+        case AssetType::SOUND:
+            entry->sound = LoadSoundFromWave(entry->wave);
+            UnloadWave(entry->wave);
+            entry->wave = Wave{0};
+            break;
+        case AssetType::MUSIC:
+            break;
+    }
+
+    entry->state = State::READY;
+    TraceLog(LOG_INFO, "Loaded %s %s in %.0f ms", TypeName(entry->type), entry->file.c_str(),
+             (GetTime() - entry->requestTime) * 1000.0);
+}
+
+AssetLoader::Entry* AssetLoader::FindReady(AssetType type, const std::string& path) {
+    auto it = entries.find(path);
+    if (it == entries.end()) {
+        // Not declared by any scene; start it now and pick it up later
+        TraceLog(LOG_WARNING, "Undeclared %s requested: %s", TypeName(type), path.c_str());
+        Request(type, path);
+        return nullptr;
+    }
+
+    Entry* entry = it->second.get();
+    if (entry->type != type || entry->state != State::READY) {
+        return nullptr;
+    }
+    return entry;
+}
+
+bool AssetLoader::IsReady(AssetType type, const std::string& path) {
+    auto it = entries.find(path);
+    return it != entries.end() && it->second->type == type && it->second->state == State::READY;
+}
+
+bool AssetLoader::IsPending() const {
+    for (const auto& pair : entries) {
+        if (pair.second->state == State::QUEUED || pair.second->state == State::DECODED) {
+            return true;
+        }
+    }
+    return false;
+}
+
+const Texture2D* AssetLoader::GetTexture(const std::string& path) {
+    Entry* entry = FindReady(AssetType::TEXTURE, path);
+    return entry ? &entry->texture : nullptr;
+}
+
+const Sound* AssetLoader::GetSound(const std::string& path) {
+    Entry* entry = FindReady(AssetType::SOUND, path);
+    return entry ? &entry->sound : nullptr;
+}
+
+Music* AssetLoader::GetMusic(const std::string& path) {
+    Entry* entry = FindReady(AssetType::MUSIC, path);
+    return entry ? &entry->music : nullptr;
+}
+
+void AssetLoader::Unload() {
+    // Workers finish the asset they are on; anything still queued is dropped
+    StopWorkers();
+    Upload(INT_MAX);
+
+    for (auto& pair : entries) {
+        Entry* entry = pair.second.get();
+        if (entry->state != State::READY) {
+            continue;
+        }
+        switch (entry->type) {
+            case AssetType::TEXTURE: UnloadTexture(entry->texture); break;
+            case AssetType::SOUND: UnloadLoadedSound(entry->sound); break;
+            case AssetType::MUSIC: UnloadMusicStream(entry->music); break;
+        }
+    }
+    entries.clear();
+}
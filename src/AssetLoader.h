@@ -0,0 +1,123 @@
+#pragma once
+#include <raylib.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "LockFreeQueue.h"
+
+// Full path of a file under the game's resources directory, which is
+// looked for next to the executable first and then in the working
+// directory.
+std::string ResourcePath(const std::string& relative);
+
+// Bytes of a resource inside resources.pak (found the same way as the
+// directory), mapped for the life of the game and followed by a zero byte.
+// False when there is no pack or it lacks the file; use ResourcePath then.
+bool FindPackedResource(const std::string& relative, const unsigned char** data, int* size);
+
+// Name the asset cooker gives a resource's decode-friendly variant
+// (QOI for images, QOA for compressed audio), or "" if it has none
+std::string CookedResourceName(const std::string& relative);
+
+enum class AssetType {
+    TEXTURE,
+    SOUND,
+    MUSIC
+};
+
+// Loads textures, sounds and music streams in the background.
+//
+// Assets are named by their path relative to resources/ and read from
+// resources.pak when it has them (preferring the cooked variant), else
+// from the loose file. Worker threads do the file reads and decoding
+// (images, waves, music stream setup); Poll() finishes the step that
+// needs the main thread, such as the texture upload. Lookups never wait:
+// an asset that is still loading reads as missing, so callers skip it for
+// that frame instead of stalling.
+class AssetLoader {
+private:
+    enum class State {
+        QUEUED,
+        DECODED,    // Worker is done, upload pending
+        READY,
+        FAILED
+    };
+
+    struct Entry {
+        AssetType type;
+        std::string path;              // Relative, the lookup key
+        std::string file;              // Resolved on the main thread
+        const unsigned char* packed = nullptr;   // In resources.pak, if there
+        int packedSize = 0;
+        std::string fileType;          // Extension of what is decoded
+        State state = State::QUEUED;   // Main thread only
+        bool decodeFailed = false;     // Set by the worker
+        bool released = false;         // Dropped while the worker had it
+        Image image = {0};
+        Wave wave = {0};
+        Music music = {0};
+        Texture2D texture = {0};
+        Sound sound = {0};
+        double requestTime = 0.0;
+    };
+
+    std::map<std::string, std::unique_ptr<Entry>> entries;
+    std::function<void(const Sound&)> soundUnloadHandler;
+
+    std::vector<std::thread> workers;
+    std::deque<Entry*> queue;
+    std::mutex queueMutex;
+    std::condition_variable queueReady;
+    bool stopping = false;
+    MpscQueue<Entry*> decoded;
+    std::deque<Entry*> uploads;    // Decoded, waiting for the main thread
+
+    static const int TEXTURE_UPLOADS_PER_FRAME = 1;
+
+    void WorkerLoop();
+    void StopWorkers();
+    void Decode(Entry* entry);
+    void Upload(int textureBudget);
+    void Finish(Entry* entry);
+    void Discard(Entry* entry);
+    void UnloadLoadedSound(Sound& sound);
+    Entry* FindReady(AssetType type, const std::string& path);
+
+public:
+    explicit AssetLoader(int workerCount = 2);
+    ~AssetLoader();
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    // Queue an asset for loading; does nothing if it is already known
+    void Request(AssetType type, const std::string& path);
+
+    // Drop an asset: unloads it, or cancels it if it has not loaded yet
+    void Release(const std::string& path);
+
+    // Called with each loaded sound just before it is unloaded, so players
+    // holding aliases of it can let go
+    void SetSoundUnloadHandler(std::function<void(const Sound&)> handler) { soundUnloadHandler = handler; }
+
+    // Upload what the worker finished (at most TEXTURE_UPLOADS_PER_FRAME
+    // textures); main thread, once per frame
+    void Poll();
+
+    bool IsReady(AssetType type, const std::string& path);
+    bool IsPending() const;
+
+    // Null until the asset has loaded (or for ever, if it failed)
+    const Texture2D* GetTexture(const std::string& path);
+    const Sound* GetSound(const std::string& path);
+    Music* GetMusic(const std::string& path);
+
+    // Stop loading and release every asset; call before the window and
+    // audio device close. Later requests are ignored.
+    void Unload();
+};
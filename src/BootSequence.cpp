@@ -0,0 +1,81 @@
+#include "BootSequence.h"
+#include <cstdio>
+
+void BootSequence::Start(const Event* eventTable, int count) {
+    events = eventTable;
+    eventCount = count;
+    nextEvent = 0;
+    time = 0.0f;
+    running = true;
+    finished = false;
+    lineCount = 0;
+    progressFormat = nullptr;
+    progressPercent = -1;
+}
+
+void BootSequence::Stop() {
+    running = false;
+    events = nullptr;
+    eventCount = 0;
+}
+
+int BootSequence::Update(float dt) {
+    int cue = -1;
+    if (!running || finished) return cue;
+
+    time += dt;
+    while (nextEvent < eventCount && events[nextEvent].time <= time) {
+        Apply(events[nextEvent], cue);
+        nextEvent++;
+        if (finished) break;
+    }
+
+    if (progressFormat) {
+        UpdateProgress();
+    }
+    return cue;
+}
+
+void BootSequence::Apply(const Event& event, int& cue) {
+    switch (event.action) {
+        case Action::PRINT:
+            // A progress line still running when the next line prints is
+            // completed, so it never stops short of 100%
+            if (progressFormat) {
+                snprintf(LineBuffer(lineCount - 1), LINE_LENGTH, progressFormat, 100);
+                progressFormat = nullptr;
+            }
+            snprintf(LineBuffer(lineCount), LINE_LENGTH, "%s", event.text ? event.text : "");
+            lineCount++;
+            break;
+        case Action::PROGRESS:
+            if (lineCount == 0) break;
+            progressFormat = event.text;
+            progressStart = event.time;
+            progressDuration = event.value;
+            progressPercent = -1;
+            UpdateProgress();
+            break;
+        case Action::SOUND:
+            cue = static_cast<int>(event.value);
+            break;
+        case Action::END:
+            finished = true;
+            break;
+    }
+}
+
+void BootSequence::UpdateProgress() {
+    float progress = (progressDuration > 0.0f) ? (time - progressStart) / progressDuration : 1.0f;
+    int percent = static_cast<int>(progress * 100.0f);
+    if (percent < 0) percent = 0;
+    if (percent > 100) percent = 100;
+
+    if (percent != progressPercent) {
+        progressPercent = percent;
+        snprintf(LineBuffer(lineCount - 1), LINE_LENGTH, progressFormat, percent);
+    }
+    if (percent == 100) {
+        progressFormat = nullptr;
+    }
+}
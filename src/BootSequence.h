@@ -0,0 +1,69 @@
+#pragma once
+
+// Timed boot screen driven by a declarative event table.
+//
+// The table is a sorted list of (time, action, text) events. Each frame
+// only the events that have come due are applied, by advancing an index,
+// and printed lines are copied into a fixed ring of line buffers, so
+// running the sequence never allocates. Start() rewinds everything, which
+// makes the scene restartable.
+class BootSequence {
+public:
+    enum class Action {
+        PRINT,      // Append text as a new line
+        PROGRESS,   // Rewrite the last line as printf(text, percent) over `value` seconds
+        SOUND,      // Report sound cue `value` from Update()
+        END         // The sequence is finished
+    };
+
+    struct Event {
+        float time;
+        Action action;
+        const char* text;
+        float value;
+    };
+
+    static const int MAX_LINES = 64;
+    static const int LINE_LENGTH = 64;
+
+private:
+    const Event* events = nullptr;
+    int eventCount = 0;
+    int nextEvent = 0;
+    float time = 0.0f;
+    bool running = false;
+    bool finished = false;
+
+    // Ring of printed lines; the oldest is dropped when it fills up
+    char lines[MAX_LINES][LINE_LENGTH];
+    int lineCount = 0;      // Lines printed since Start()
+
+    // Active PROGRESS event
+    const char* progressFormat = nullptr;
+    float progressStart = 0.0f;
+    float progressDuration = 0.0f;
+    int progressPercent = -1;
+
+    char* LineBuffer(int index) { return lines[index % MAX_LINES]; }
+    void Apply(const Event& event, int& cue);
+    void UpdateProgress();
+
+public:
+    // `events` must be sorted by time and outlive the sequence
+    void Start(const Event* events, int eventCount);
+    void Stop();
+
+    // Advances the clock and applies due events; returns the last sound
+    // cue reached this frame, or -1
+    int Update(float dt);
+
+    bool IsRunning() const { return running; }
+    bool IsFinished() const { return finished; }
+    float GetTime() const { return time; }
+
+    // Lines are numbered from the start of the sequence; only the last
+    // MAX_LINES of them are still held
+    int GetLineCount() const { return lineCount; }
+    int GetFirstLine() const { return (lineCount > MAX_LINES) ? lineCount - MAX_LINES : 0; }
+    const char* GetLine(int index) const { return lines[index % MAX_LINES]; }
+};
@@ -1,4 +1,7 @@
 #include "BreachProtocol.h"
+#include "TextMetrics.h"
+
+std::atomic<uint64_t> BreachProtocol::lastVersion{0};
 
 BreachProtocol::BreachProtocol(int width, int height)
     : screenWidth(width),
@@ -8,7 +11,8 @@ BreachProtocol::BreachProtocol(int width, int height)
       currentCol(0),
       gameWon(false),
       gameLost(false),
-      timer(START_TIME) {
+      timer(START_TIME),
+      version(0) {
     initializeGame();
 }
 
@@ -29,64 +33,67 @@ void BreachProtocol::initializeGame() {
     isVerticalMove = false;
     currentRow = 0;
     currentCol = 0;
+    touch();
 }
 
-void BreachProtocol::update() {
+void BreachProtocol::update(float deltaTime) {
     if (gameWon || gameLost) return;
 
-    timer -= GetFrameTime();
+    timer -= deltaTime;
     if (timer <= 0) {
         timer = 0;
         gameLost = true;
-        return;
+        touch();
     }
+}
+
+void BreachProtocol::click(Vector2 mousePos) {
+    if (gameWon || gameLost) return;
+
+    const int cellWidth = 60;
+    const int cellHeight = 30;
+    const int startX = (screenWidth - (MATRIX_SIZE * (cellWidth + CELL_PADDING))) / 2;
+    const int startY = 50;
+
+    int col = (mousePos.x - startX) / (cellWidth + CELL_PADDING);
+    int row = (mousePos.y - startY) / (cellHeight + CELL_PADDING);
 
-    if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-        Vector2 mousePos = GetMousePosition();
-        const int cellWidth = 60;
-        const int cellHeight = 30;
-        const int startX = (screenWidth - (MATRIX_SIZE * (cellWidth + CELL_PADDING))) / 2;
-        const int startY = 50;
-
-        int col = (mousePos.x - startX) / (cellWidth + CELL_PADDING);
-        int row = (mousePos.y - startY) / (cellHeight + CELL_PADDING);
-
-        if (row >= 0 && row < MATRIX_SIZE && col >= 0 && col < MATRIX_SIZE) {
-            if (buffer.size() < BUFFER_SIZE) {
-                bool validMove = false;
-
-                if (selectedPositions.empty()) {
-                    if (row == 0) {
-                        validMove = true;
-                        currentCol = col;
-                        isVerticalMove = true;
-                    }
-                } else {
-                    if (isVerticalMove && col == currentCol && row != selectedPositions.back().row) {
-                        validMove = true;
-                        currentRow = row;
-                        isVerticalMove = false;
-                    } else if (!isVerticalMove && row == currentRow && col != selectedPositions.back().col) {
-                        validMove = true;
-                        currentCol = col;
-                        isVerticalMove = true;
-                    }
+    if (row >= 0 && row < MATRIX_SIZE && col >= 0 && col < MATRIX_SIZE) {
+        if (buffer.size() < BUFFER_SIZE) {
+            bool validMove = false;
+
+            if (selectedPositions.empty()) {
+                if (row == 0) {
+                    validMove = true;
+                    currentCol = col;
+                    isVerticalMove = true;
+                }
+            } else {
+                if (isVerticalMove && col == currentCol && row != selectedPositions.back().row) {
+                    validMove = true;
+                    currentRow = row;
+                    isVerticalMove = false;
+                } else if (!isVerticalMove && row == currentRow && col != selectedPositions.back().col) {
+                    validMove = true;
+                    currentCol = col;
+                    isVerticalMove = true;
                 }
+            }
 
-                if (validMove) {
-                    buffer.push_back(matrix[row][col]);
-                    selectedPositions.push_back({row, col});
+            if (validMove) {
+                buffer.push_back(matrix[row][col]);
+                selectedPositions.push_back({row, col});
 
-                    if (buffer == requiredSequence) {
-                        gameWon = true;
-                    }
+                if (buffer == requiredSequence) {
+                    gameWon = true;
                 }
+                touch();
             }
         }
     }
 }
 
-void BreachProtocol::draw() {
+void BreachProtocol::draw(float timeLeft) const {
     // Define basic layout constants
     const int cellWidth = 60;
     const int cellHeight = 30;
@@ -99,9 +106,9 @@ void BreachProtocol::draw() {
     // Draw title and timer
     DrawText("CODE MATRIX", startX, startY - 30, 20, GREEN);
     // Timer changes color to red when time is running low (less than 3 seconds)
-    DrawText(TextFormat("TIME: %.1f", timer),
+    DrawText(TextFormat("TIME: %.1f", timeLeft),
             startX + (MATRIX_SIZE * (cellWidth + CELL_PADDING)) - 100,  // Right-aligned
-            startY - 30, 20, timer > 3 ? GREEN : RED);
+            startY - 30, 20, timeLeft > 3 ? GREEN : RED);
 
     // Draw the main code matrix grid
     for (int i = 0; i < MATRIX_SIZE; i++) {
@@ -136,7 +143,7 @@ void BreachProtocol::draw() {
             // Draw cell content (the code)
             const char* text = matrix[i][j].c_str();
             // Center the text within the cell
-            Vector2 textSize = MeasureTextEx(GetFontDefault(), text, 20, 1);
+            Vector2 textSize = TextMetrics::Instance().MeasureEx(GetFontDefault(), text, 20, 1);
             Vector2 textPos = {
                 cell.x + (cell.width - textSize.x) / 2,
                 cell.y + (cell.height - textSize.y) / 2
@@ -167,7 +174,7 @@ void BreachProtocol::draw() {
         // If this buffer position has been filled, draw the code
         if (i < buffer.size()) {
             const char* text = buffer[i].c_str();
-            Vector2 textSize = MeasureTextEx(GetFontDefault(), text, 20, 1);
+            Vector2 textSize = TextMetrics::Instance().MeasureEx(GetFontDefault(), text, 20, 1);
             Vector2 textPos = {
                 cell.x + (cell.width - textSize.x) / 2,
                 cell.y + (cell.height - textSize.y) / 2
@@ -195,7 +202,7 @@ void BreachProtocol::draw() {
         DrawRectangleLinesEx(cell, 1, GREEN);
         // Draw the required code (in yellow to distinguish from buffer)
         const char* text = requiredSequence[i].c_str();
-        Vector2 textSize = MeasureTextEx(GetFontDefault(), text, 20, 1);
+        Vector2 textSize = TextMetrics::Instance().MeasureEx(GetFontDefault(), text, 20, 1);
         Vector2 textPos = {
             cell.x + (cell.width - textSize.x) / 2,
             cell.y + (cell.height - textSize.y) / 2
@@ -205,12 +212,12 @@ void BreachProtocol::draw() {
     // Draw game state messages
     if (gameWon) {
         const char* winText = "BREACH SUCCESSFUL!";
-        int textWidth = MeasureText(winText, 30);
+        int textWidth = TextMetrics::Instance().Measure(winText, 30);
         // Center the success message
         DrawText(winText, (screenWidth - textWidth) / 2, screenHeight - 70, 30, GREEN);
     } else if (gameLost) {
         const char* loseText = "BREACH FAILED!";
-        int textWidth = MeasureText(loseText, 30);
+        int textWidth = TextMetrics::Instance().Measure(loseText, 30);
         // Center the failure message
         DrawText(loseText, (screenWidth - textWidth) / 2, screenHeight - 70, 30, RED);
     }
@@ -1,5 +1,7 @@
 #pragma once
 #include <raylib.h>
+#include <atomic>
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <random>
@@ -30,9 +32,15 @@ class BreachProtocol {
         int screenWidth;
         int screenHeight;
 
+        // Bumped whenever the board changes (not the countdown), unique
+        // across instances so a copy can tell whether it is current
+        uint64_t version;
+        static std::atomic<uint64_t> lastVersion;
+        void touch() { version = ++lastVersion; }
+
         // pre-defined matrices bc im too lazy to figure out why the random one doesn't work
         // rip A* pathfinding
-        const std::vector<std::vector<std::vector<std::string>>> predefinedMatrices = {
+        static inline const std::vector<std::vector<std::vector<std::string>>> predefinedMatrices = {
             { // Matrix 1
                 {"1C", "E9", "BD", "55", "1C"},
                 {"BD", "55", "1C", "E9", "BD"},
@@ -56,7 +64,7 @@ class BreachProtocol {
             }
         };
 
-        const std::vector<std::vector<std::string>> predefinedSequences = {
+        static inline const std::vector<std::vector<std::string>> predefinedSequences = {
             {"E9", "BD", "1C", "BD"},
             {"1C", "BD", "E9", "55"},
             {"E9", "1C", "BD", "55"}
@@ -64,8 +72,13 @@ class BreachProtocol {
 
     public:
     BreachProtocol(int width, int height);
-    void update();
-    void draw();
+    void click(Vector2 position);     // Left click at a screen position
+    void update(float deltaTime);    // Countdown, on simulated time
+    // The countdown is passed in, so a published copy of the board only
+    // has to be refreshed when getVersion() moves
+    void draw(float timeLeft) const;
+    float getTimeLeft() const { return timer; }
+    uint64_t getVersion() const { return version; }
     void reset();
     bool isComplete() const { return gameWon || gameLost; }
     bool isSuccessful() const { return gameWon; }
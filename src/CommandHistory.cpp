@@ -0,0 +1,196 @@
+#include "CommandHistory.h"
+#include <raylib.h>
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+
+CommandHistory::CommandHistory(const std::string& path)
+    : filePath(path), writable(true) {}
+
+CommandHistory& CommandHistory::Instance() {
+    static CommandHistory history(std::string(GetApplicationDirectory()) + "terminal_history.bin");
+    static bool loaded = false;
+    if (!loaded) {
+        history.Load();
+        loaded = true;
+    }
+    return history;
+}
+
+uint32_t CommandHistory::Trigram(const char* text) {
+    return (static_cast<uint32_t>(static_cast<unsigned char>(text[0])) << 16) |
+           (static_cast<uint32_t>(static_cast<unsigned char>(text[1])) << 8) |
+            static_cast<uint32_t>(static_cast<unsigned char>(text[2]));
+}
+
+void CommandHistory::IndexEntry(uint32_t id) {
+    const std::string& entry = entries[id];
+    for (size_t i = 0; i + 3 <= entry.size(); i++) {
+        std::vector<uint32_t>& postings = trigramIndex[Trigram(&entry[i])];
+        // Repeated trigrams inside one entry only need one posting
+        if (postings.empty() || postings.back() != id) {
+            postings.push_back(id);
+        }
+    }
+    for (unsigned char byte : entry) {
+        std::vector<uint32_t>& postings = byteIndex[byte];
+        if (postings.empty() || postings.back() != id) {
+            postings.push_back(id);
+        }
+    }
+}
+
+void CommandHistory::Load() {
+    FILE* file = fopen(filePath.c_str(), "rb");
+    if (!file) {
+        return;
+    }
+
+    unsigned char header[4] = {0};
+    if (fread(header, 1, 4, file) != 4 || header[0] != 'T' || header[1] != 'I' ||
+        header[2] != 'H' || header[3] != FILE_VERSION) {
+        TraceLog(LOG_WARNING, "HISTORY: Unrecognized history file, not using it: %s", filePath.c_str());
+        writable = false;
+        fclose(file);
+        return;
+    }
+
+    std::string command;
+    long goodEnd = ftell(file);   // End of the last complete record
+    bool damaged = false;
+    while (true) {
+        // LEB128 record length; five bytes cover 32 bits
+        uint32_t length = 0;
+        int shift = 0;
+        int byte = 0;
+        while ((byte = fgetc(file)) != EOF) {
+            length |= static_cast<uint32_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) break;
+            shift += 7;
+            if (shift > 28) {
+                byte = EOF;
+                damaged = true;
+                break;
+            }
+        }
+        if (byte == EOF) {
+            // Ending mid-length is an interrupted write too
+            damaged = damaged || ftell(file) != goodEnd;
+            break;
+        }
+
+        if (length > MAX_COMMAND_BYTES) {
+            damaged = true;
+            break;
+        }
+        command.resize(length);
+        if (length > 0 && fread(&command[0], 1, length, file) != length) {
+            damaged = true;  // Truncated tail from an interrupted write
+            break;
+        }
+        entries.push_back(command);
+        IndexEntry(static_cast<uint32_t>(entries.size() - 1));
+        goodEnd = ftell(file);
+    }
+    fclose(file);
+
+    // New records must follow the last good one, not the garbage
+    if (damaged) {
+        std::error_code error;
+        std::filesystem::resize_file(filePath, static_cast<uintmax_t>(goodEnd), error);
+        if (error) {
+            TraceLog(LOG_WARNING, "HISTORY: Damaged history file, not writing to it: %s", filePath.c_str());
+            writable = false;
+        } else {
+            TraceLog(LOG_WARNING, "HISTORY: Dropped a damaged tail from %s", filePath.c_str());
+        }
+    }
+
+    TraceLog(LOG_INFO, "HISTORY: Loaded %zu entries", entries.size());
+}
+
+void CommandHistory::AppendToFile(const std::string& command) {
+    if (!writable) {
+        return;
+    }
+
+    FILE* file = fopen(filePath.c_str(), "ab");
+    if (!file) {
+        return;
+    }
+
+    // Append streams may report position 0 until the first write
+    fseek(file, 0, SEEK_END);
+    if (ftell(file) == 0) {
+        const unsigned char header[4] = {'T', 'I', 'H', FILE_VERSION};
+        fwrite(header, 1, 4, file);
+    }
+
+    unsigned char lengthBytes[5];
+    int count = 0;
+    uint32_t length = static_cast<uint32_t>(command.size());
+    do {
+        unsigned char byte = length & 0x7f;
+        length >>= 7;
+        lengthBytes[count++] = length ? (byte | 0x80) : byte;
+    } while (length);
+
+    fwrite(lengthBytes, 1, count, file);
+    fwrite(command.data(), 1, command.size(), file);
+    fclose(file);
+}
+
+void CommandHistory::Add(const std::string& command) {
+    if (command.empty()) {
+        return;
+    }
+    // Like most shells, don't store the same command twice in a row
+    if (!entries.empty() && entries.back() == command) {
+        return;
+    }
+
+    entries.push_back(command);
+    IndexEntry(static_cast<uint32_t>(entries.size() - 1));
+    if (command.size() <= MAX_COMMAND_BYTES) {
+        AppendToFile(command);
+    }
+}
+
+int CommandHistory::SearchBackward(const std::string& query, int before) const {
+    before = std::min(before, static_cast<int>(entries.size()));
+    if (before <= 0) {
+        return -1;
+    }
+
+    if (query.empty()) {
+        return before - 1;
+    }
+
+    // Walk the rarest byte's or trigram's postings, verifying each candidate
+    const std::vector<uint32_t>* rarest = nullptr;
+    if (query.size() < 3) {
+        for (unsigned char byte : query) {
+            if (!rarest || byteIndex[byte].size() < rarest->size()) {
+                rarest = &byteIndex[byte];
+            }
+        }
+    }
+    for (size_t i = 0; i + 3 <= query.size(); i++) {
+        auto it = trigramIndex.find(Trigram(&query[i]));
+        if (it == trigramIndex.end()) {
+            return -1;
+        }
+        if (!rarest || it->second.size() < rarest->size()) {
+            rarest = &it->second;
+        }
+    }
+
+    auto end = std::lower_bound(rarest->begin(), rarest->end(), static_cast<uint32_t>(before));
+    while (end != rarest->begin()) {
+        --end;
+        if (entries[*end].find(query) != std::string::npos) {
+            return static_cast<int>(*end);
+        }
+    }
+    return -1;
+}
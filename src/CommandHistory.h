@@ -0,0 +1,45 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Shell history shared by every Terminal instance.
+//
+// Entries are appended to a binary file as they are entered:
+//   header  "TIH" + version byte
+//   record  LEB128 length + raw command bytes
+// A damaged tail (an interrupted write, a corrupt length) is cut off at
+// the last complete record on load, so later appends stay readable.
+// A trigram index (trigram -> ascending entry ids) keeps reverse search
+// proportional to the rarest trigram of the query, not the history size;
+// a byte index does the same for one- and two-character queries.
+class CommandHistory {
+private:
+    static const uint8_t FILE_VERSION = 1;
+    static constexpr uint32_t MAX_COMMAND_BYTES = 64 * 1024;   // Longer records are corrupt
+
+    std::vector<std::string> entries;
+    std::unordered_map<uint32_t, std::vector<uint32_t>> trigramIndex;
+    std::vector<uint32_t> byteIndex[256];
+    std::string filePath;
+    bool writable;
+
+    void IndexEntry(uint32_t id);
+    void AppendToFile(const std::string& command);
+    static uint32_t Trigram(const char* text);
+
+public:
+    explicit CommandHistory(const std::string& path);
+
+    static CommandHistory& Instance();
+
+    void Load();
+    void Add(const std::string& command);
+
+    size_t Size() const { return entries.size(); }
+    const std::string& Get(size_t index) const { return entries[index]; }
+
+    // Newest entry with id < before that contains query, or -1
+    int SearchBackward(const std::string& query, int before) const;
+};
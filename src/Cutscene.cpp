@@ -0,0 +1,263 @@
+#include "Cutscene.h"
+#include "TextMetrics.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+// A time, or "-" for none
+static bool ReadTime(std::istringstream& in, float& value) {
+    std::string token;
+    if (!(in >> token)) return false;
+    if (token == "-") {
+        value = -1.0f;
+        return true;
+    }
+    char* end = nullptr;
+    value = strtof(token.c_str(), &end);
+    return end != token.c_str() && *end == '\0';
+}
+
+// Optional trailing "r g b [a]"
+static void ReadColor(std::istringstream& in, Color& color) {
+    int r, g, b;
+    if (!(in >> r >> g >> b)) return;
+    int a = 255;
+    if (!(in >> a)) a = 255;
+    color = Color{(unsigned char)r, (unsigned char)g, (unsigned char)b, (unsigned char)a};
+}
+
+bool Cutscene::Load(const char* timeline) {
+    name = timeline;
+    images.clear();
+    texts.clear();
+    cues.clear();
+    crt = CrtEffect{};
+    endTime = -1.0f;
+
+    std::istringstream stream;
+    const unsigned char* packed = nullptr;
+    int packedSize = 0;
+    if (FindPackedResource(timeline, &packed, &packedSize)) {
+        stream.str(std::string(reinterpret_cast<const char*>(packed), packedSize));
+    } else {
+        std::string file = ResourcePath(timeline);
+        char* data = LoadFileText(file.c_str());
+        if (!data) {
+            TraceLog(LOG_ERROR, "Cutscene not found: %s", file.c_str());
+            return false;
+        }
+        stream.str(data);
+        UnloadFileText(data);
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(stream, line)) {
+        lineNumber++;
+        std::istringstream in(line);
+        std::string command;
+        if (!(in >> command) || command[0] == '#') {
+            continue;
+        }
+
+        bool ok = false;
+        if (command == "image") {
+            ImageLayer layer;
+            std::string path;
+            ok = ReadTime(in, layer.start) && ReadTime(in, layer.end) && (in >> path);
+            if (ok) {
+                layer.path = path;
+                ReadColor(in, layer.tint);
+                images.push_back(layer);
+            }
+        } else if (command == "sweep") {
+            // Applies to the image declared above it
+            float start, duration;
+            ok = !images.empty() && ReadTime(in, start) && ReadTime(in, duration) && duration > 0;
+            if (ok) {
+                images.back().sweepStart = start;
+                images.back().sweepDuration = duration;
+            }
+        } else if (command == "text") {
+            TextOverlay text;
+            ok = ReadTime(in, text.start) && ReadTime(in, text.end) &&
+                 (in >> text.y >> text.fontSize >> std::quoted(text.text));
+            if (ok) {
+                ReadColor(in, text.color);
+                texts.push_back(text);
+            }
+        } else if (command == "sound") {
+            SoundCue cue;
+            std::string path;
+            ok = ReadTime(in, cue.time) && (in >> path);
+            if (ok) {
+                cue.path = path;
+                cues.push_back(cue);
+            }
+        } else if (command == "crt") {
+            ok = static_cast<bool>(in >> crt.scanlineSpacing >> crt.darkLineSpacing >>
+                                   crt.distortionSpacing >> crt.glitchChance);
+            crt.enabled = ok;
+        } else if (command == "end") {
+            ok = ReadTime(in, endTime);
+        }
+
+        if (!ok) {
+            TraceLog(LOG_WARNING, "Cutscene %s:%d: cannot read '%s'", timeline, lineNumber, line.c_str());
+        }
+    }
+
+    std::stable_sort(images.begin(), images.end(),
+                     [](const ImageLayer& a, const ImageLayer& b) { return a.start < b.start; });
+    std::stable_sort(cues.begin(), cues.end(),
+                     [](const SoundCue& a, const SoundCue& b) { return a.time < b.time; });
+    return true;
+}
+
+void Cutscene::DeclareAssets(std::vector<AssetRequest>& requests) const {
+    // Only the opening images; the rest are streamed while it plays
+    int count = 0;
+    for (const ImageLayer& layer : images) {
+        if (layer.start > PREFETCH_SECONDS || count == PREFETCH_IMAGES) break;
+        requests.push_back({AssetType::TEXTURE, layer.path});
+        count++;
+    }
+    for (const SoundCue& cue : cues) {
+        requests.push_back({AssetType::SOUND, cue.path});
+    }
+}
+
+bool Cutscene::IsActive(float start, float end, float time) {
+    return time >= start && (end < 0.0f || time < end);
+}
+
+void Cutscene::Start(AssetLoader& loader) {
+    assets = &loader;
+    time = 0.0f;
+    previousTime = 0.0f;
+    nextCue = 0;
+    for (ImageLayer& layer : images) {
+        layer.requested = false;
+        layer.released = false;
+    }
+    UpdateImages();
+}
+
+void Cutscene::Stop() {
+    if (!assets) return;
+    for (ImageLayer& layer : images) {
+        if (layer.requested && !layer.released) {
+            assets->Release(layer.path);
+            layer.released = true;
+        }
+    }
+    assets = nullptr;
+}
+
+void Cutscene::Update(float dt) {
+    if (!assets) return;
+    previousTime = time;
+    time += dt;
+    UpdateImages();
+}
+
+void Cutscene::UpdateImages() {
+    int ahead = 0;
+    for (ImageLayer& layer : images) {
+        if (layer.released) {
+            continue;
+        }
+
+        if (layer.end >= 0.0f && time >= layer.end) {
+            // Keep the texture if a later layer shows the same image
+            bool shared = false;
+            for (const ImageLayer& other : images) {
+                if (&other != &layer && other.path == layer.path && !other.released &&
+                    (other.end < 0.0f || time < other.end)) {
+                    shared = true;
+                    break;
+                }
+            }
+            if (layer.requested && !shared) {
+                assets->Release(layer.path);
+            }
+            layer.released = true;
+            continue;
+        }
+
+        if (layer.start > time) {
+            if (layer.start - time > PREFETCH_SECONDS || ahead == PREFETCH_IMAGES) {
+                continue;
+            }
+            ahead++;
+        }
+        if (!layer.requested) {
+            assets->Request(AssetType::TEXTURE, layer.path);
+            layer.requested = true;
+        }
+    }
+}
+
+const std::string* Cutscene::NextCue() {
+    if (nextCue < cues.size() && cues[nextCue].time <= time) {
+        return &cues[nextCue++].path;
+    }
+    return nullptr;
+}
+
+void Cutscene::Draw(Rectangle frame, int screenWidth, int screenHeight, float alpha, Rectangle& crtArea) {
+    crtArea = Rectangle{0, 0, 0, 0};
+    if (!assets) return;
+
+    float drawTime = previousTime + (time - previousTime) * alpha;
+
+    for (const ImageLayer& layer : images) {
+        if (layer.released || !IsActive(layer.start, layer.end, drawTime)) {
+            continue;
+        }
+
+        // Not uploaded yet: the layer simply appears a frame later
+        const Texture2D* texture = assets->GetTexture(layer.path);
+        if (!texture || texture->width == 0 || texture->height == 0) {
+            continue;
+        }
+
+        float scale = fmin(frame.width / texture->width, frame.height / texture->height);
+        int drawWidth = (int)(texture->width * scale);
+        int drawHeight = (int)(texture->height * scale);
+        int drawX = (int)frame.x + ((int)frame.width - drawWidth) / 2;
+        int drawY = (int)frame.y + ((int)frame.height - drawHeight) / 2;
+        Rectangle source = {0, 0, (float)texture->width, (float)texture->height};
+        Rectangle dest = {(float)drawX, (float)drawY, (float)drawWidth, (float)drawHeight};
+
+        if (layer.sweepDuration > 0.0f) {
+            // A band half the image tall scans from the bottom to the top,
+            // and the image is gone once it has passed
+            float progress = std::max(0.0f, (drawTime - layer.sweepStart) / layer.sweepDuration);
+            if (progress >= 1.0f) {
+                continue;
+            }
+            float maskY = drawHeight * (1.0f - progress);
+            float maskWidth = drawWidth * 1.2f;
+            float maskHeight = drawHeight / 2.0f;
+
+            BeginScissorMode(drawX - (int)((maskWidth - drawWidth) / 2),
+                             drawY + (int)maskY - maskHeight, (int)maskWidth, (int)maskHeight);
+            DrawTexturePro(*texture, source, dest, Vector2{0, 0}, 0.0f, layer.tint);
+            EndScissorMode();
+        } else {
+            DrawTexturePro(*texture, source, dest, Vector2{0, 0}, 0.0f, layer.tint);
+        }
+        crtArea = dest;
+    }
+
+    for (const TextOverlay& text : texts) {
+        if (!IsActive(text.start, text.end, drawTime)) {
+            continue;
+        }
+        int width = TextMetrics::Instance().Measure(text.text, text.fontSize);
+        int y = (text.y < 0) ? screenHeight + text.y : text.y;
+        DrawText(text.text.c_str(), (screenWidth - width) / 2, y, text.fontSize, text.color);
+    }
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include <raylib.h>
+#include <string>
+#include <vector>
+#include "AssetLoader.h"
+#include "Scene.h"
+
+// Cutscene player driven by a timeline file.
+//
+// A timeline lists image layers, sweep masks, text overlays and sound
+// cues with start and end times (see resources/cutscenes/descent.txt for
+// the format). Images are requested from the AssetLoader a little before
+// they are due, so they decode on its worker and upload just in time, and
+// are released once their layer ends; only the images around the play
+// head are held in memory.
+class Cutscene {
+public:
+    struct CrtEffect {
+        bool enabled = false;
+        float scanlineSpacing = 0.0f;
+        float darkLineSpacing = 0.0f;
+        float distortionSpacing = 0.0f;
+        int glitchChance = 0;
+    };
+
+private:
+    struct ImageLayer {
+        float start = 0.0f;
+        float end = -1.0f;            // < 0 holds to the end
+        std::string path;
+        Color tint = WHITE;
+        float sweepStart = 0.0f;      // Scanning band, if sweepDuration > 0
+        float sweepDuration = 0.0f;
+        bool requested = false;
+        bool released = false;
+    };
+
+    struct TextOverlay {
+        float start = 0.0f;
+        float end = -1.0f;
+        int y = 0;                    // Negative counts up from the bottom
+        int fontSize = 20;
+        Color color = GREEN;
+        std::string text;
+    };
+
+    struct SoundCue {
+        float time = 0.0f;
+        std::string path;
+    };
+
+    // How far ahead images are requested, and at most how many at once
+    static constexpr float PREFETCH_SECONDS = 3.0f;
+    static const int PREFETCH_IMAGES = 2;
+
+    std::string name;
+    std::vector<ImageLayer> images;   // Sorted by start
+    std::vector<TextOverlay> texts;
+    std::vector<SoundCue> cues;       // Sorted by time
+    CrtEffect crt;
+    float endTime = -1.0f;            // < 0 waits for the scene to move on
+
+    AssetLoader* assets = nullptr;
+    float time = 0.0f;
+    float previousTime = 0.0f;        // Before the last Update()
+    size_t nextCue = 0;
+
+    static bool IsActive(float start, float end, float time);
+    void UpdateImages();
+
+public:
+    // Parses a timeline under resources/; problems are logged and the
+    // line skipped. Paths inside the file are relative to resources/ too.
+    bool Load(const char* timeline);
+
+    // Assets needed at the start, for Scene::DeclareAssets
+    void DeclareAssets(std::vector<AssetRequest>& requests) const;
+
+    void Start(AssetLoader& assets);
+    void Stop();
+    void Update(float dt);
+
+    // Sound cues reached since the last call, one at a time
+    const std::string* NextCue();
+
+    // Draws the layers fitted into `frame` at `alpha` of the way from the
+    // previous update to the last; the area the CRT effect should cover
+    // is stored in crtArea (zero size when none)
+    void Draw(Rectangle frame, int screenWidth, int screenHeight, float alpha, Rectangle& crtArea);
+
+    bool IsFinished() const { return endTime >= 0.0f && time >= endTime; }
+    const CrtEffect& GetCrtEffect() const { return crt; }
+};
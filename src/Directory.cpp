@@ -1,4 +1,5 @@
 #include "Directory.h"
+#include <algorithm>
 #include <iostream>
 
 // Static member initializations
@@ -11,7 +12,7 @@ float Directory::thoughtTimer = 0.0f;
 
 Directory::Directory(const std::string& name, Directory* parent, bool isHidden, bool isDir,
                      const std::string& owner, const std::string& group)
-    : name(name), parent(parent), leftChild(nullptr), rightSibling(nullptr),
+    : name(name), content(std::make_shared<const std::string>()), parent(parent), leftChild(nullptr), rightSibling(nullptr),
       isHidden(isHidden), owner(owner), group(group), size(4096), isDirectory(isDir),
       isBinary(false), hiddenOffset(0), isNetworkConfig(false), isLocked(false),
       analysisAttempts(MAX_ANALYSIS_ATTEMPTS) {
@@ -117,7 +118,7 @@ std::string Directory::analyzeFile() {
                 "\nWarning: Connection attempts being logged";
 
         case 0:
-            return generateHexDump(content) +
+            return generateHexDump(*content) +
                 "\nAnalysis complete. No further attempts allowed.\n"
                 "Tip: Some servers require non-standard ports for SSH connections.";
 
@@ -206,7 +207,7 @@ Directory* Directory::addSubdirectory(const std::string& name, bool isHidden) {
 
 Directory* Directory::addFile(const std::string& name, const std::string& content, bool isBinary) {
     Directory* newFile = new Directory(name, this, false, false);
-    newFile->content = content;
+    newFile->content = std::make_shared<const std::string>(content);
     newFile->isBinary = isBinary;
     if (!leftChild) {
         leftChild = newFile;
@@ -232,12 +233,20 @@ Directory* Directory::FindFile(const std::string& filename) {
 }
 
 std::string Directory::getVisibleContent() const {
-    return content.substr(0, hiddenOffset);
+    return content->substr(0, hiddenOffset);
+}
+
+std::shared_ptr<LineIndex> Directory::getLineIndex() const {
+    if (!lineIndex) {
+        lineIndex = std::make_shared<LineIndex>(content, std::min(hiddenOffset, content->size()));
+    }
+    return lineIndex;
 }
 
 void Directory::setContent(const std::string& visibleContent) {
-    content = visibleContent;
+    content = std::make_shared<const std::string>(visibleContent);
     hiddenOffset = visibleContent.length();
+    lineIndex.reset();
 }
 
 Directory* Directory::CreateFileSystem() {
@@ -1,14 +1,17 @@
 #pragma once
+#include <memory>
 #include <string>
 #include <vector>
 #include <sstream>
 #include <iomanip>
 #include <ctime>
+#include "LineIndex.h"
 
 class Directory {
 private:
     std::string name;
-    std::string content;
+    std::shared_ptr<const std::string> content;
+    mutable std::shared_ptr<LineIndex> lineIndex;  // Built on first cat, dropped on setContent
     std::string permissions;
     Directory* parent;
     Directory* leftChild;
@@ -53,7 +56,7 @@ public:
     Directory* getRightSibling() const { return rightSibling; }
     bool getIsHidden() const { return isHidden; }
     bool getIsDirectory() const { return isDirectory; }
-    std::string getFullContent() const { return content; }
+    std::string getFullContent() const { return *content; }
 
     // Network config methods
     bool isConfigFile() const { return isNetworkConfig; }
@@ -76,6 +79,7 @@ public:
     std::string DisplayTree(int level = 0, bool isLast = true) const;
     std::string GetDetailedInfo() const;
     std::string getVisibleContent() const;
+    std::shared_ptr<LineIndex> getLineIndex() const;
 
     void setContent(const std::string& visibleContent);
 
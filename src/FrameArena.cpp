@@ -0,0 +1,207 @@
+#include "FrameArena.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+FrameArena& FrameArena::Instance() {
+    thread_local FrameArena arena;
+    return arena;
+}
+
+static size_t AlignUp(size_t value, size_t align) {
+    return (value + align - 1) & ~(align - 1);
+}
+
+char* FrameArena::Fit(size_t size, size_t align) {
+    // Try the current block, then later ones kept from earlier frames,
+    // and only then grow. An oversized request gets a block of its own.
+    while (current < blocks.size()) {
+        Block& block = blocks[current];
+        uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+        size_t start = AlignUp(base + offset, align) - base;
+        if (start + size <= block.size) {
+            offset = start + size;
+            lastAllocation = start;
+            return block.data.get() + start;
+        }
+        current++;
+        offset = 0;
+    }
+
+    Block block;
+    block.size = std::max(BLOCK_SIZE, size + align);
+    block.data.reset(new char[block.size]);
+    blocks.push_back(std::move(block));
+    current = blocks.size() - 1;
+    offset = 0;
+    return Fit(size, align);
+}
+
+void* FrameArena::Allocate(size_t size, size_t align) {
+    return Fit(size, align);
+}
+
+bool FrameArena::Extend(const void* allocation, size_t newSize) {
+    if (current >= blocks.size()) {
+        return false;
+    }
+    Block& block = blocks[current];
+    if (allocation != block.data.get() + lastAllocation || lastAllocation + newSize > block.size) {
+        return false;
+    }
+    offset = std::max(offset, lastAllocation + newSize);
+    return true;
+}
+
+void FrameArena::Reset() {
+    current = 0;
+    offset = 0;
+    lastAllocation = 0;
+}
+
+size_t FrameArena::GetCapacity() const {
+    size_t total = 0;
+    for (const Block& block : blocks) {
+        total += block.size;
+    }
+    return total;
+}
+
+FrameString::FrameString(size_t capacity, FrameArena& arena)
+    : arena(arena),
+      capacity(capacity) {
+    data = static_cast<char*>(arena.Allocate(capacity + 1, 1));
+    data[0] = '\0';
+}
+
+void FrameString::Reserve(size_t needed) {
+    if (needed <= capacity) {
+        return;
+    }
+    size_t grown = std::max(needed, capacity * 2);
+    if (!arena.Extend(data, grown + 1)) {
+        // The old buffer is abandoned until the arena resets
+        char* moved = static_cast<char*>(arena.Allocate(grown + 1, 1));
+        memcpy(moved, data, length + 1);
+        data = moved;
+    }
+    capacity = grown;
+}
+
+FrameString& FrameString::Append(std::string_view text) {
+    Reserve(length + text.size());
+    memcpy(data + length, text.data(), text.size());
+    length += text.size();
+    data[length] = '\0';
+    return *this;
+}
+
+FrameString& FrameString::Append(char c, size_t count) {
+    Reserve(length + count);
+    memset(data + length, c, count);
+    length += count;
+    data[length] = '\0';
+    return *this;
+}
+
+FrameString& FrameString::AppendInt(long long value) {
+    char digits[24];
+    int count = snprintf(digits, sizeof(digits), "%lld", value);
+    return Append(std::string_view(digits, count));
+}
+
+void FrameString::Clear() {
+    length = 0;
+    data[0] = '\0';
+}
+
+// Allocation counting
+
+#ifdef COUNT_ALLOCATIONS
+static thread_local unsigned long long threadAllocations = 0;
+
+static void* CountedAllocate(size_t size) {
+    threadAllocations++;
+    void* memory = malloc(size ? size : 1);
+    if (!memory) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new(size_t size) { return CountedAllocate(size); }
+void* operator new[](size_t size) { return CountedAllocate(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    threadAllocations++;
+    return malloc(size ? size : 1);
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    threadAllocations++;
+    return malloc(size ? size : 1);
+}
+
+// Over-aligned types (alignas beyond max_align_t) come through these;
+// MSVC has no aligned_alloc and needs the matching _aligned_free
+static void* AlignedMalloc(size_t size, std::align_val_t align) {
+    size_t alignment = static_cast<size_t>(align);
+    size = AlignUp(size ? size : 1, alignment);
+#ifdef _WIN32
+    return _aligned_malloc(size, alignment);
+#else
+    return aligned_alloc(alignment, size);
+#endif
+}
+
+static void AlignedFree(void* memory) {
+#ifdef _WIN32
+    _aligned_free(memory);
+#else
+    free(memory);
+#endif
+}
+
+static void* CountedAllocate(size_t size, std::align_val_t align) {
+    threadAllocations++;
+    void* memory = AlignedMalloc(size, align);
+    if (!memory) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new(size_t size, std::align_val_t align) { return CountedAllocate(size, align); }
+void* operator new[](size_t size, std::align_val_t align) { return CountedAllocate(size, align); }
+void* operator new(size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    threadAllocations++;
+    return AlignedMalloc(size, align);
+}
+void* operator new[](size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    threadAllocations++;
+    return AlignedMalloc(size, align);
+}
+
+void operator delete(void* memory) noexcept { free(memory); }
+void operator delete[](void* memory) noexcept { free(memory); }
+void operator delete(void* memory, size_t) noexcept { free(memory); }
+void operator delete[](void* memory, size_t) noexcept { free(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { free(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { free(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { AlignedFree(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { AlignedFree(memory); }
+void operator delete(void* memory, size_t, std::align_val_t) noexcept { AlignedFree(memory); }
+void operator delete[](void* memory, size_t, std::align_val_t) noexcept { AlignedFree(memory); }
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept { AlignedFree(memory); }
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept { AlignedFree(memory); }
+
+bool AllocationCounter::IsEnabled() { return true; }
+unsigned long long AllocationCounter::ThreadCount() { return threadAllocations; }
+#else
+bool AllocationCounter::IsEnabled() { return false; }
+unsigned long long AllocationCounter::ThreadCount() { return 0; }
+#endif
@@ -0,0 +1,84 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+// Bump allocator for memory that only has to last until the end of a
+// frame: text assembled for drawing, snapshot strings and the like.
+//
+// Allocating moves an offset; Reset() at the end of the frame takes it
+// back to the start. Blocks are kept across resets, so once the arena has
+// grown to a frame's needs it never touches the heap again. Each thread
+// has its own arena and resets it at its own frame boundary.
+class FrameArena {
+private:
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+    struct Block {
+        std::unique_ptr<char[]> data;
+        size_t size = 0;
+    };
+
+    std::vector<Block> blocks;
+    size_t current = 0;   // Block being filled
+    size_t offset = 0;    // Bytes used in it
+    size_t lastAllocation = 0;   // Offset of the newest allocation, for Extend()
+
+    char* Fit(size_t size, size_t align);
+
+public:
+    static FrameArena& Instance();   // Per thread
+
+    FrameArena() = default;
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void* Allocate(size_t size, size_t align = alignof(std::max_align_t));
+
+    // Grows the newest allocation in place to newSize bytes; false if it
+    // is not the newest or the block has no room
+    bool Extend(const void* allocation, size_t newSize);
+
+    // Frees everything allocated since the last reset
+    void Reset();
+
+    size_t GetCapacity() const;
+};
+
+// String assembled in the frame arena, always NUL-terminated so it can go
+// straight to raylib. Valid until the arena is reset; not copyable, since
+// copies would share the buffer.
+class FrameString {
+private:
+    FrameArena& arena;
+    char* data;
+    size_t length = 0;
+    size_t capacity;   // Excluding the terminator
+
+    void Reserve(size_t needed);
+
+public:
+    explicit FrameString(size_t capacity = 64, FrameArena& arena = FrameArena::Instance());
+    FrameString(const FrameString&) = delete;
+    FrameString& operator=(const FrameString&) = delete;
+
+    FrameString& Append(std::string_view text);
+    FrameString& Append(char c, size_t count = 1);
+    FrameString& AppendInt(long long value);
+    void Clear();
+
+    std::string_view View() const { return std::string_view(data, length); }
+    const char* CStr() const { return data; }
+    size_t Size() const { return length; }
+    bool IsEmpty() const { return length == 0; }
+};
+
+// Counts heap allocations per thread when built with COUNT_ALLOCATIONS,
+// which replaces the global operator new; otherwise the count stays 0.
+// Compare counts around a frame to check it allocated nothing.
+class AllocationCounter {
+public:
+    static bool IsEnabled();
+    static unsigned long long ThreadCount();   // Made by the calling thread so far
+};
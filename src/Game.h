@@ -1,147 +1,134 @@
 #pragma once
 #include <raylib.h>
 #include <string>
-#include <map>
-#include "BreachProtocol.h"
-#include "Terminal.h"
 #include "Directory.h"
-#include "PopupDialog.h"
+#include "AssetLoader.h"
+#include "FrameArena.h"
+#include "InputQueue.h"
+#include "MusicPlayer.h"
+#include "VoicePool.h"
+#include "SceneStack.h"
+#include "Simulation.h"
+#include "TaskGraph.h"
+#include <chrono>
 
 class Game {
 private:
+    // Internal resolution: scenes lay out and draw at this size, and the
+    // result is scaled to whatever size the window has
     int screenWidth;
     int screenHeight;
-    bool showStartScreen;
-    bool showMissionBrief;
-    bool showActionScene1;
-    bool showRetroBootUp;
-    bool startFadeToTerminal;
-    float fadeAlpha;
-    size_t missionTextIndex;
-    int typewriterSpeed;
-    int typewriterCounter;
-    int transitionDelay;
-    int transitionCounter;
-    std::string missionText;
 
+    // Startup work runs as a task graph while the title screen is up;
+    // the simulation is running once terminalTask is done
+    TaskGraph startup;
+    int terminalTask;
+    std::chrono::steady_clock::time_point launchTime;
+    bool firstFrameReported;
+
+    // Scenes run from a stack; each declares its assets so the next
+    // scene's load in the background while the current one plays
+    AssetLoader assets;
+    SceneStack scenes;
+    InputQueue input;             // Polled once per frame, then taken from
+    Music* currentMusic;          // Last track handed to musicPlayer
+    std::string requestedMusic;   // Starts once loaded
+    float requestedMusicVolume;
+    float requestedMusicFade;
+    MusicPlayer musicPlayer;      // Streams on its own thread
+    VoicePool voices;             // Sound effects, a bounded voice count
+
+    // CRT post-processing: every scene draws into sceneTarget, then a single
+    // shader pass applies scanlines, distortion and glitch to crt.area while
+    // scaling the target into presentRect
+    struct CrtSettings {
+        Rectangle area;            // Zero size disables the effect
+        float scanlineSpacing;
+        float darkLineSpacing;
+        float distortionSpacing;
+        int glitchChance;          // Percent chance of a glitch flash per frame
+    };
     bool shaderLoaded;
     int scanlineIntensityLoc;
     int greenTintLoc;
-    Texture2D actionScene1;
-    bool scenesLoaded;
-    Shader greenTintShader;
+    int resolutionLoc;
+    int effectRectLoc;
+    int timeLoc;
+    int scanlineSpacingLoc;
+    int darkLineSpacingLoc;
+    int distortionSpacingLoc;
+    int glitchLoc;
+    Shader crtShader;
+    RenderTexture2D sceneTarget;
+    CrtSettings crt;
+    float crtTime;
+
+    // Where sceneTarget lands in the window; recomputed only on resize.
+    // Whole-number scales use point filtering so pixels stay square.
+    bool integerScaling;
+    Rectangle presentRect;
+
+    // Idle throttling: the terminal drops to IDLE_FPS once nothing has
+    // changed for IDLE_DELAY seconds; F2 toggles it
+    static const int ACTIVE_FPS = 60;
+    static const int IDLE_FPS = 20;
+    static constexpr float IDLE_DELAY = 1.0f;
+    bool idleThrottleEnabled;
+    bool idleThrottled;
+    float idleTime;
 
-    Sound typingSounds[4];
-    Sound retroPCsounds[2];
-    Music music[2];
+    // Fixed-step animation: scenes tick every SIM_STEP of frame time and
+    // rendering blends the last two steps by frameAlpha, so they run the
+    // same at any frame rate. A long frame is clamped to MAX_FRAME_TIME so
+    // a stall does not snowball into a burst of steps.
+    static constexpr float SIM_STEP = 1.0f / 120.0f;
+    static constexpr float MAX_FRAME_TIME = 0.25f;
+    float simAccumulator;
+    float frameAlpha;
 
-    Directory* filesystem;
-    Terminal terminal;
+    // Terminal and breach state live on the simulation thread; scenes
+    // draw from the snapshot acquired at the start of each frame
+    Directory* filesystem;        // Until the simulation takes it over
+    Simulation simulation;
+    unsigned handledRestarts;
 
     // Initialization methods
     void Initialize();
-    void LoadScenes();
     void UnloadScenes();
-    void LoadSounds();
-    void UnloadSounds();
-    void loadMusic();
-    void unloadMusic();
-    void SetupFilesystem();
-    void ProcessTerminalInput();
+    void LoadCrtShader();
+    void UpdatePresentation();
+    bool HasInputActivity() const;
+    bool IsSceneAnimating() const;
+    void UpdateFramePacing();
+    void AdvanceSimulation(float dt);
+    void SetCrtArea(Rectangle area, float scanlineSpacing, float darkLineSpacing,
+                    float distortionSpacing, int glitchChance);
+    void DrawCrtPass();
 
-    // Drawing methods
-    void DrawStartScreen();
-    void DrawMissionBrief();
-    void DrawActionScene1();
-    void DrawRetroBootUp();
-    void DrawTerminal();
+    // Scene services
+    bool IsTerminalReady() const { return startup.IsDone(terminalTask); }
+    float GetFrameAlpha() const { return frameAlpha; }
+    const SimulationSnapshot& View() { return simulation.View(); }
+    std::unique_ptr<Scene> CreateScene(SceneId id);
+    void PlayMusic(const std::string& path, float volume, float fadeSeconds = 0.0f);
+    void StopMusic();
+    void UpdateMusic();
+    void PlaySoundAsset(const std::string& path, SoundBus bus, SoundPriority priority);
 
-    //breach protocol members
-    BreachProtocol* breachGame;
-    bool showBreachProtocol;
-    bool breachLoading;
-    float breachLoadTimer;
-    int breachAttempts;
-    Sound floppySound;
-
-    // breach methods
-    void DrawBreachLoading();
-    void DrawBreachProtocol();
-    void ProcessBreachInput();
-
-    // Ending handling - keeping your existing enum class
-    enum class GameEnding {
-        NONE,
-        BAD_ENDING,
-        GOOD_ENDING
-    };
-    GameEnding currentEnding;
-    PopupDialog endingDialog;
-    std::map<GameEnding, std::string> endingTexts;
-
-    // Ending methods
-    void DrawEndingDialog();
-    void ShowEnding(const std::string& message);
-    void InitializeEndingTexts();
-    void HandleEndingState();
     void ResetGame();
 
-    // Add ending texts mapped to your enum
-    const std::string GOOD_ENDING_TEXT =
-        "With full knowledge of the Regime's true nature...\n"
-        "You decide to sabotage the launch codes before submission.\n"
-        "The nuclear strike fails.\n"
-        "Your conscience is clear, but your days are numbered...\n"
-        "\n"
-        "OPERATION OUTCOME: ETHICAL INTERVENTION\n"
-        "\n"
-        "Having discovered the truth about the Regime's atrocities, you chose\n"
-        "to act against their plans.\n"
-        "\n"
-        "CONSEQUENCES:\n"
-        "- Launch codes were successfully corrupted before transmission\n"
-        "- Nuclear strike failed across all targeted locations\n"
-        "- Millions of civilian lives saved from immediate destruction\n"
-        "- Evidence of the Regime's true nature has been preserved\n"
-        "\n"
-        "Your conscious decision to sabotage the operation prevented what would\n"
-        "have been one of the largest civilian massacres in history. The evidence\n"
-        "you discovered may help bring the truth to light.\n"
-        "\n"
-        "However, your actions have not gone unnoticed. The Regime's retribution\n"
-        "will be swift and merciless. You've sacrificed your safety for the lives\n"
-        "of millions.\n"
-        "\n"
-        "GOOD ENDING: Conscious Objector\n"
-        "\n"
-        "You chose to stand against tyranny, whatever the personal cost.\n";
-
-    const std::string BAD_ENDING_TEXT =
-        "Submitting launch codes to Regime Command...\n"
-        "Authorization codes verified.\n"
-        "Launch sequence initiated.\n"
-        "\n"
-        "OPERATION OUTCOME: CATASTROPHIC FAILURE\n"
-        "\n"
-        "You submitted the launch codes to Regime Command without discovering the truth.\n"
-        "\n"
-        "CONSEQUENCES:\n"
-        "- Nuclear weapons strike Alliance territory with devastating accuracy\n"
-        "- Millions of civilian casualties reported across multiple population centers\n"
-        "- Humanitarian aid camps and civilian shelters were primary targets\n"
-        "- The Regime's true nature remains hidden from the world\n"
-        "\n"
-        "Your unwitting cooperation helped facilitate one of the largest-scale\n"
-        "civilian massacres in history. The Regime's propaganda machine ensures\n"
-        "that history remembers this as a 'necessary peacekeeping operation.'\n"
-        "\n"
-        "BAD ENDING: Unwitting Accomplice\n"
-        "\n"
-        "Perhaps if you had explored more of the system, you might have\n"
-        "discovered the truth about the Regime's true intentions...\n";
+    friend class StartScene;
+    friend class BriefScene;
+    friend class CutsceneScene;
+    friend class BootScene;
+    friend class TerminalScene;
+    friend class BreachLoadingScene;
+    friend class BreachScene;
 
 public:
-    Game(int screenWidth, int screenHeight);
+    // integerScaling keeps whole-number scales (letterboxed) whenever the
+    // window is at least the internal size; otherwise the image is fitted
+    Game(int screenWidth, int screenHeight, bool integerScaling = true);
     ~Game();
     void Run();
 };
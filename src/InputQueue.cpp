@@ -0,0 +1,88 @@
+#include "InputQueue.h"
+#include <raylib.h>
+#include <algorithm>
+
+InputQueue::InputQueue() {
+    // Sized for a burst of typing, so polling does not allocate
+    events.reserve(64);
+    heldKeys.reserve(16);
+}
+
+void InputQueue::Poll() {
+    events.clear();
+
+    auto now = std::chrono::steady_clock::now();
+    bool ctrl = IsKeyDown(KEY_LEFT_CONTROL) || IsKeyDown(KEY_RIGHT_CONTROL);
+
+    // Keys go after the text, so ENTER submits what was typed with it
+    bool combo = false;
+    for (size_t i = 0; i < heldKeys.size();) {
+        int key = heldKeys[i];
+        if (!IsKeyDown(key)) {
+            heldKeys.erase(heldKeys.begin() + i);
+            continue;
+        }
+        if (IsKeyPressedRepeat(key)) {
+            events.push_back({InputEvent::KEY, key, ctrl, true, now});
+        }
+        i++;
+    }
+    for (int key = GetKeyPressed(); key > 0; key = GetKeyPressed()) {
+        events.push_back({InputEvent::KEY, key, ctrl, false, now});
+        combo = combo || (ctrl && key != KEY_LEFT_CONTROL && key != KEY_RIGHT_CONTROL);
+        if (std::find(heldKeys.begin(), heldKeys.end(), key) == heldKeys.end()) {
+            heldKeys.push_back(key);
+        }
+    }
+
+    // Text is slotted in ahead of the keys; a combo's text is dropped
+    std::vector<InputEvent>::iterator textEnd = events.begin();
+    for (int codepoint = GetCharPressed(); codepoint > 0; codepoint = GetCharPressed()) {
+        if (!combo) {
+            textEnd = events.insert(textEnd, {InputEvent::CHAR, codepoint, ctrl, false, now}) + 1;
+        }
+    }
+}
+
+bool InputQueue::Next(InputEvent& event) {
+    if (events.empty()) {
+        return false;
+    }
+    event = events.front();
+    events.erase(events.begin());
+    return true;
+}
+
+bool InputQueue::TakeKey(int key) {
+    for (auto it = events.begin(); it != events.end(); ++it) {
+        if (it->type == InputEvent::KEY && it->code == key && !it->repeat) {
+            events.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool InputQueue::TakeAnyKey() {
+    for (auto it = events.begin(); it != events.end(); ++it) {
+        if (it->type == InputEvent::KEY && !it->repeat) {
+            events.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+void InputLatency::Record(std::chrono::steady_clock::time_point collected) {
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - collected).count();
+    count++;
+    totalMs += ms;
+    maxMs = std::max(maxMs, ms);
+
+    if (count >= REPORT_EVENTS) {
+        TraceLog(LOG_DEBUG, "INPUT: %d events, latency avg %.2f ms, max %.2f ms", count, totalMs / count, maxMs);
+        count = 0;
+        totalMs = 0.0;
+        maxMs = 0.0;
+    }
+}
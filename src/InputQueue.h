@@ -0,0 +1,62 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+struct InputEvent {
+    enum Type : uint8_t {
+        KEY,
+        CHAR
+    };
+
+    Type type = KEY;
+    int code = 0;            // raylib key code, or a codepoint for CHAR
+    bool ctrl = false;       // A control key was held
+    bool repeat = false;     // Auto-repeat of a held key
+    std::chrono::steady_clock::time_point time;   // When it was collected
+};
+
+// Key and text input for one frame, collected once.
+//
+// Poll() runs first thing each frame and reads raylib's key and char
+// queues into one list, oldest first; anything nobody took last frame is
+// dropped. Consumers take events out, so each is handled exactly once
+// however many scenes and components look at the queue. Held keys repeat
+// at the system rate, and the text typed along with a control combo is
+// discarded so the C of CTRL+C never reaches a prompt.
+class InputQueue {
+private:
+    std::vector<InputEvent> events;
+    std::vector<int> heldKeys;       // Pressed and not yet released
+
+public:
+    InputQueue();
+
+    void Poll();
+
+    // Oldest event, removed from the queue
+    bool Next(InputEvent& event);
+
+    // Removes the first fresh press of `key`; repeats do not count
+    bool TakeKey(int key);
+
+    // Removes the first fresh press of any key
+    bool TakeAnyKey();
+
+    void Clear() { events.clear(); }
+    bool IsEmpty() const { return events.empty(); }
+};
+
+// Time from collection until an event took effect, logged at LOG_DEBUG
+// every REPORT_EVENTS events
+class InputLatency {
+private:
+    static const int REPORT_EVENTS = 256;
+
+    int count = 0;
+    double totalMs = 0.0;
+    double maxMs = 0.0;
+
+public:
+    void Record(std::chrono::steady_clock::time_point collected);
+};
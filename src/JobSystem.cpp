@@ -0,0 +1,110 @@
+#include "JobSystem.h"
+#include <chrono>
+
+void JobContext::Print(const std::string& line) {
+    JobEvent event;
+    event.jobId = job->id;
+    event.line = line;
+    system->events.Push(std::move(event));
+}
+
+void JobContext::OnTerminalThread(std::function<void()> callback) {
+    JobEvent event;
+    event.jobId = job->id;
+    event.callback = std::move(callback);
+    system->events.Push(std::move(event));
+}
+
+bool JobContext::Wait(float seconds) {
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::milliseconds(static_cast<int>(seconds * 1000.0f));
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (IsCancelled()) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return !IsCancelled();
+}
+
+JobSystem::JobSystem(int workerCount) {
+    for (int i = 0; i < workerCount; i++) {
+        workers.emplace_back(&JobSystem::WorkerLoop, this);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        stopping = true;
+        for (auto& job : pending) {
+            job->cancelRequested = true;
+        }
+    }
+    for (auto& entry : jobs) {
+        entry.second->cancelRequested = true;
+    }
+    pendingReady.notify_all();
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void JobSystem::WorkerLoop() {
+    while (true) {
+        std::shared_ptr<Job> job;
+        {
+            std::unique_lock<std::mutex> lock(pendingMutex);
+            pendingReady.wait(lock, [this] { return stopping || !pending.empty(); });
+            if (stopping) {
+                return;
+            }
+            job = pending.front();
+            pending.pop_front();
+        }
+
+        if (!job->cancelRequested) {
+            job->state = JobState::RUNNING;
+            JobContext context(this, job.get());
+            job->work(context);
+        }
+
+        job->state = job->cancelRequested ? JobState::CANCELLED : JobState::DONE;
+
+        JobEvent done;
+        done.jobId = job->id;
+        done.finished = true;
+        events.Push(std::move(done));
+    }
+}
+
+int JobSystem::Submit(const std::string& command, std::function<void(JobContext&)> work, bool background) {
+    auto job = std::make_shared<Job>();
+    job->id = nextJobId++;
+    job->command = command;
+    job->background = background;
+    job->work = std::move(work);
+    jobs[job->id] = job;
+
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        pending.push_back(job);
+    }
+    pendingReady.notify_one();
+    return job->id;
+}
+
+bool JobSystem::Cancel(int jobId) {
+    auto job = Find(jobId);
+    if (!job) {
+        return false;
+    }
+    job->cancelRequested = true;
+    return true;
+}
+
+std::shared_ptr<Job> JobSystem::Find(int jobId) const {
+    auto it = jobs.find(jobId);
+    return it != jobs.end() ? it->second : nullptr;
+}
@@ -0,0 +1,96 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "LockFreeQueue.h"
+
+class JobSystem;
+
+enum class JobState {
+    QUEUED,
+    RUNNING,
+    DONE,
+    CANCELLED
+};
+
+// Message sent from a worker back to the terminal thread (the one that
+// owns the JobSystem and drains its events)
+struct JobEvent {
+    int jobId = 0;
+    bool finished = false;
+    std::string line;
+    std::function<void()> callback;
+};
+
+struct Job {
+    int id = 0;
+    std::string command;
+    bool background = false;
+    std::function<void(class JobContext&)> work;
+    std::atomic<bool> cancelRequested{false};
+    std::atomic<JobState> state{JobState::QUEUED};
+};
+
+// Handed to a job's work function. Everything here is safe to call from
+// the worker thread.
+class JobContext {
+private:
+    JobSystem* system;
+    Job* job;
+
+public:
+    JobContext(JobSystem* system, Job* job) : system(system), job(job) {}
+
+    int GetId() const { return job->id; }
+    bool IsCancelled() const { return job->cancelRequested.load(std::memory_order_relaxed); }
+
+    // Queue a line for the terminal output
+    void Print(const std::string& line);
+
+    // Run a function on the terminal thread during the next drain
+    void OnTerminalThread(std::function<void()> callback);
+
+    // Sleep in small steps; returns false as soon as the job is cancelled
+    bool Wait(float seconds);
+};
+
+class JobSystem {
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::shared_ptr<Job>> pending;
+    std::mutex pendingMutex;
+    std::condition_variable pendingReady;
+    bool stopping = false;
+
+    MpscQueue<JobEvent> events;
+
+    // Terminal thread bookkeeping
+    std::map<int, std::shared_ptr<Job>> jobs;
+    int nextJobId = 1;
+
+    void WorkerLoop();
+
+    friend class JobContext;
+
+public:
+    explicit JobSystem(int workerCount = 2);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Terminal thread API
+    int Submit(const std::string& command, std::function<void(JobContext&)> work, bool background);
+    bool Cancel(int jobId);
+    bool PopEvent(JobEvent& event) { return events.Pop(event); }
+    void Forget(int jobId) { jobs.erase(jobId); }
+    std::shared_ptr<Job> Find(int jobId) const;
+    const std::map<int, std::shared_ptr<Job>>& GetJobs() const { return jobs; }
+};
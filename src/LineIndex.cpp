@@ -0,0 +1,84 @@
+#include "LineIndex.h"
+#include <algorithm>
+#include <cstring>
+
+// Bytes scanned per step when indexing lazily
+static const size_t scanChunk = 64 * 1024;
+
+LineIndex::LineIndex(std::shared_ptr<const std::string> text, size_t length)
+    : text(std::move(text)), length(length), scanned(0), complete(length == 0) {
+    if (length > 0) {
+        starts.push_back(0);
+    }
+}
+
+void LineIndex::ScanNext() {
+    const char* data = text->data();
+    size_t end = std::min(length, scanned + scanChunk);
+
+    while (scanned < end) {
+        const void* found = memchr(data + scanned, '\n', end - scanned);
+        if (!found) {
+            scanned = end;
+            break;
+        }
+        size_t newline = static_cast<const char*>(found) - data;
+        if (newline + 1 < length) {
+            starts.push_back(static_cast<uint32_t>(newline + 1));
+        }
+        scanned = newline + 1;
+    }
+
+    if (scanned >= length) {
+        complete = true;
+    }
+}
+
+bool LineIndex::IndexThrough(size_t line) {
+    // Line i is known once line i + 1 has started, or the buffer is done
+    while (!complete && starts.size() <= line + 1) {
+        ScanNext();
+    }
+    return line < IndexedLines();
+}
+
+void LineIndex::IndexAll() {
+    while (!complete) {
+        ScanNext();
+    }
+}
+
+size_t LineIndex::IndexedLines() const {
+    if (complete) {
+        return starts.size();
+    }
+    // The last start has no known end yet
+    return starts.empty() ? 0 : starts.size() - 1;
+}
+
+size_t LineIndex::LineCount() {
+    IndexAll();
+    return starts.size();
+}
+
+std::string_view LineIndex::Line(size_t line) const {
+    size_t begin = starts[line];
+    size_t end = 0;
+    if (line + 1 < starts.size()) {
+        end = starts[line + 1] - 1;
+    } else {
+        end = length;
+        if (end > begin && (*text)[end - 1] == '\n') {
+            end--;
+        }
+    }
+    return std::string_view(text->data() + begin, end - begin);
+}
+
+size_t LineIndex::LineAtOffset(size_t offset) {
+    while (!complete && (starts.empty() || starts.back() <= offset)) {
+        ScanNext();
+    }
+    size_t line = std::upper_bound(starts.begin(), starts.end(), static_cast<uint32_t>(offset)) - starts.begin();
+    return line > 0 ? line - 1 : 0;
+}
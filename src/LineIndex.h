@@ -0,0 +1,44 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Line start offsets into a shared, immutable text buffer.
+//
+// Lines are split on '\n' the same way std::getline does (a trailing
+// newline does not produce an extra empty line). Indexing is lazy: only
+// as much of the buffer is scanned as the requested lines need, so a
+// pager can open a huge file without touching its tail.
+class LineIndex {
+private:
+    std::shared_ptr<const std::string> text;
+    size_t length;                 // Indexed extent of text
+    std::vector<uint32_t> starts;  // Content buffers stay far below 4 GiB
+    size_t scanned;
+    bool complete;
+
+    void ScanNext();
+
+public:
+    LineIndex(std::shared_ptr<const std::string> text, size_t length);
+
+    // Scan until `line` is fully indexed or the buffer ends
+    bool IndexThrough(size_t line);
+    void IndexAll();
+
+    bool IsComplete() const { return complete; }
+    size_t IndexedLines() const;
+    size_t LineCount();
+
+    // Line containing byte `offset`, indexing as far as needed
+    size_t LineAtOffset(size_t offset);
+
+    size_t LineStart(size_t line) const { return starts[line]; }
+    size_t Length() const { return length; }
+    const std::string& Text() const { return *text; }
+
+    // Requires IndexThrough(line) to have returned true
+    std::string_view Line(size_t line) const;
+};
@@ -0,0 +1,91 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+// Unbounded multi-producer / single-consumer queue (Vyukov style).
+// Producers never wait on each other or on the consumer; the consumer
+// polls with Pop() and gets false when nothing is ready.
+template <typename T>
+class MpscQueue {
+private:
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        T value{};
+    };
+
+    std::atomic<Node*> head;
+    Node* tail;
+
+public:
+    MpscQueue() {
+        Node* stub = new Node();
+        head.store(stub, std::memory_order_relaxed);
+        tail = stub;
+    }
+
+    ~MpscQueue() {
+        T discarded;
+        while (Pop(discarded)) {}
+        delete tail;
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // Safe to call from any thread
+    void Push(T value) {
+        Node* node = new Node();
+        node->value = std::move(value);
+        Node* prev = head.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    // Consumer thread only
+    bool Pop(T& out) {
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (!next) {
+            return false;
+        }
+        out = std::move(next->value);
+        delete tail;
+        tail = next;
+        return true;
+    }
+};
+
+// Bounded single-producer / single-consumer ring. Neither side ever waits:
+// Push() returns false when the ring is full, Pop() when it is empty.
+// Capacity must be a power of two.
+template <typename T, size_t Capacity>
+class SpscRing {
+private:
+    static_assert((Capacity & (Capacity - 1)) == 0, "SpscRing capacity must be a power of two");
+
+    T slots[Capacity];
+    alignas(64) std::atomic<size_t> head{0};   // Next slot to write, producer
+    alignas(64) std::atomic<size_t> tail{0};   // Next slot to read, consumer
+
+public:
+    // Producer thread only
+    bool Push(const T& value) {
+        size_t write = head.load(std::memory_order_relaxed);
+        if (write - tail.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        slots[write & (Capacity - 1)] = value;
+        head.store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer thread only
+    bool Pop(T& out) {
+        size_t read = tail.load(std::memory_order_relaxed);
+        if (read == head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        out = slots[read & (Capacity - 1)];
+        tail.store(read + 1, std::memory_order_release);
+        return true;
+    }
+};
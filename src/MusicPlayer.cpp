@@ -0,0 +1,160 @@
+#include "MusicPlayer.h"
+#include <algorithm>
+#include <chrono>
+
+MusicPlayer::~MusicPlayer() {
+    Shutdown();
+}
+
+void MusicPlayer::Start() {
+    if (running) {
+        return;
+    }
+    running = true;
+    thread = std::thread(&MusicPlayer::ThreadLoop, this);
+}
+
+void MusicPlayer::Shutdown() {
+    if (!running) {
+        return;
+    }
+    running = false;
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+void MusicPlayer::Send(const Command& command) {
+    if (!commands.Push(command)) {
+        TraceLog(LOG_WARNING, "MUSIC: Command queue full, command dropped");
+    }
+}
+
+void MusicPlayer::Play(Music* music, float volume) {
+    Command command;
+    command.type = CommandType::PLAY;
+    command.music = music;
+    command.volume = volume;
+    Send(command);
+}
+
+void MusicPlayer::CrossfadeTo(Music* music, float volume, float seconds) {
+    Command command;
+    command.type = CommandType::CROSSFADE;
+    command.music = music;
+    command.volume = volume;
+    command.seconds = seconds;
+    Send(command);
+}
+
+void MusicPlayer::SetVolume(float volume) {
+    Command command;
+    command.type = CommandType::VOLUME;
+    command.volume = volume;
+    Send(command);
+}
+
+void MusicPlayer::Stop() {
+    Command command;
+    command.type = CommandType::STOP;
+    Send(command);
+}
+
+void MusicPlayer::ThreadLoop() {
+    auto last = std::chrono::steady_clock::now();
+    while (running) {
+        Command command;
+        while (commands.Pop(command)) {
+            Apply(command);
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        float dt = std::chrono::duration<float>(now - last).count();
+        last = now;
+
+        Advance(fading, dt);
+        Advance(current, dt);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(REFILL_INTERVAL_MS));
+    }
+
+    StopVoice(fading);
+    StopVoice(current);
+}
+
+void MusicPlayer::Apply(const Command& command) {
+    switch (command.type) {
+        case CommandType::PLAY:
+        case CommandType::CROSSFADE: {
+            if (command.music == current.music) {
+                current.volume = command.volume;
+                break;
+            }
+            StopVoice(fading);
+            bool fade = (command.type == CommandType::CROSSFADE && command.seconds > 0.0f);
+            if (fade && current.music) {
+                fading = current;
+                fading.fadeRate = -1.0f / command.seconds;
+            } else {
+                StopVoice(current);
+            }
+
+            current = Voice{};
+            current.music = command.music;
+            current.volume = command.volume;
+            current.gain = fade ? 0.0f : 1.0f;
+            current.fadeRate = fade ? 1.0f / command.seconds : 0.0f;
+            if (current.music) {
+                SetMusicVolume(*current.music, current.volume * current.gain);
+                PlayMusicStream(*current.music);
+            }
+            break;
+        }
+        case CommandType::VOLUME:
+            current.volume = command.volume;
+            break;
+        case CommandType::STOP:
+            StopVoice(fading);
+            StopVoice(current);
+            break;
+    }
+}
+
+void MusicPlayer::Advance(Voice& voice, float dt) {
+    if (!voice.music) {
+        return;
+    }
+
+    if (voice.fadeRate != 0.0f) {
+        voice.gain += voice.fadeRate * dt;
+        if (voice.gain <= 0.0f) {
+            StopVoice(voice);
+            return;
+        }
+        if (voice.gain >= 1.0f) {
+            voice.gain = 1.0f;
+            voice.fadeRate = 0.0f;
+        }
+    }
+    SetMusicVolume(*voice.music, voice.volume * voice.gain);
+
+    auto start = std::chrono::steady_clock::now();
+    UpdateMusicStream(*voice.music);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    voice.updateSeconds += seconds;
+    voice.updateMaxSeconds = std::max(voice.updateMaxSeconds, seconds);
+    voice.playedSeconds += dt;
+    voice.updates++;
+}
+
+void MusicPlayer::StopVoice(Voice& voice) {
+    if (voice.music) {
+        StopMusicStream(*voice.music);
+    }
+    if (voice.updates > 0 && voice.playedSeconds > 0.0) {
+        TraceLog(LOG_INFO, "MUSIC: UpdateMusicStream %.1f us per refill (max %.1f us, %d refills), %.3f ms per 60 Hz frame of playback",
+                 voice.updateSeconds / voice.updates * 1e6, voice.updateMaxSeconds * 1e6, voice.updates,
+                 voice.updateSeconds / voice.playedSeconds / 60.0 * 1e3);
+    }
+    voice = Voice{};
+}
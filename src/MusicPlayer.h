@@ -0,0 +1,82 @@
+#pragma once
+#include <raylib.h>
+#include <atomic>
+#include <thread>
+#include "LockFreeQueue.h"
+
+// Streams music on its own thread.
+//
+// UpdateMusicStream used to run once per rendered frame, so a long frame
+// (a big `cat`, a texture upload) let the stream buffer run dry and the
+// music stuttered. Here a dedicated thread refills the stream every few
+// milliseconds whatever the frame rate. The thread owns every Music it is
+// given: the main thread only sends play/stop/volume/crossfade commands
+// through a lock-free ring and must not call raylib's music functions on
+// them itself. The Music objects stay owned (and unloaded) by AssetLoader;
+// Shutdown() must run before they are. When a track stops, the time its
+// UpdateMusicStream calls took is logged, per refill and per 60 Hz frame of
+// playback, so decoders (MP3 against cooked QOA) compare on real streams.
+class MusicPlayer {
+private:
+    enum class CommandType {
+        PLAY,
+        STOP,
+        VOLUME,
+        CROSSFADE
+    };
+
+    struct Command {
+        CommandType type = CommandType::STOP;
+        Music* music = nullptr;
+        float volume = 1.0f;
+        float seconds = 0.0f;
+    };
+
+    // A playing stream and its fade; audio thread only
+    struct Voice {
+        Music* music = nullptr;
+        float volume = 1.0f;    // Target volume
+        float gain = 0.0f;      // Fade position, 0..1
+        float fadeRate = 0.0f;  // Gain per second, negative to fade out
+
+        // UpdateMusicStream cost while this voice plays, logged when it stops
+        double updateSeconds = 0.0;
+        double updateMaxSeconds = 0.0;
+        double playedSeconds = 0.0;
+        int updates = 0;
+    };
+
+    static constexpr int REFILL_INTERVAL_MS = 5;
+
+    SpscRing<Command, 64> commands;
+    std::thread thread;
+    std::atomic<bool> running{false};
+
+    Voice current;
+    Voice fading;     // Previous track during a crossfade
+
+    void ThreadLoop();
+    void Apply(const Command& command);
+    void Advance(Voice& voice, float dt);
+    void StopVoice(Voice& voice);
+    void Send(const Command& command);
+
+public:
+    MusicPlayer() = default;
+    ~MusicPlayer();
+    MusicPlayer(const MusicPlayer&) = delete;
+    MusicPlayer& operator=(const MusicPlayer&) = delete;
+
+    // After InitAudioDevice
+    void Start();
+
+    // Stops playback and joins the thread; call before the music is
+    // unloaded and the audio device closes
+    void Shutdown();
+
+    // Main thread commands; they take effect within a few milliseconds
+    void Play(Music* music, float volume);
+    void CrossfadeTo(Music* music, float volume, float seconds);
+    void SetVolume(float volume);
+    void Stop();
+};
@@ -0,0 +1,161 @@
+#include "Pager.h"
+#include <algorithm>
+
+void Pager::Open(const std::string& name, std::shared_ptr<LineIndex> index) {
+    lines = std::move(index);
+    title = name;
+    topLine = 0;
+    active = true;
+    searching = false;
+    searchInput.clear();
+    message.clear();
+    ClampTop();
+}
+
+void Pager::Close() {
+    active = false;
+    searching = false;
+    lines.reset();
+}
+
+void Pager::SetPageLines(int count) {
+    pageLines = std::max(1, count);
+    if (active) {
+        ClampTop();
+    }
+}
+
+void Pager::ClampTop() {
+    // Index just far enough to fill the page below the new top line
+    lines->IndexThrough(topLine + pageLines - 1);
+    if (lines->IsComplete()) {
+        size_t count = lines->IndexedLines();
+        size_t maxTop = count > static_cast<size_t>(pageLines) ? count - pageLines : 0;
+        topLine = std::min(topLine, maxTop);
+    }
+}
+
+void Pager::ScrollBy(int count) {
+    if (!active) return;
+    message.clear();
+    if (count < 0) {
+        size_t up = static_cast<size_t>(-count);
+        topLine = topLine > up ? topLine - up : 0;
+    } else {
+        topLine += count;
+    }
+    ClampTop();
+}
+
+void Pager::GoTop() {
+    message.clear();
+    topLine = 0;
+    ClampTop();
+}
+
+void Pager::GoBottom() {
+    message.clear();
+    lines->IndexAll();
+    topLine = lines->IndexedLines();
+    ClampTop();
+}
+
+void Pager::SearchForward(const std::string& query, size_t fromLine) {
+    if (query.empty()) return;
+
+    if (!lines->IndexThrough(fromLine)) {
+        message = "Pattern not found";
+        return;
+    }
+
+    std::string_view text(lines->Text().data(), lines->Length());
+    size_t found = text.find(query, lines->LineStart(fromLine));
+    if (found == std::string_view::npos) {
+        message = "Pattern not found";
+        return;
+    }
+
+    message.clear();
+    topLine = lines->LineAtOffset(found);
+    ClampTop();
+}
+
+void Pager::HandleChar(int key) {
+    if (!active) return;
+
+    if (searching) {
+        if (key >= 32 && key <= 126) {
+            searchInput += static_cast<char>(key);
+        }
+        return;
+    }
+
+    switch (key) {
+        case 'q': Close(); break;
+        case '/':
+            searching = true;
+            searchInput.clear();
+            break;
+        case 'n': SearchForward(lastSearch, topLine + 1); break;
+        case 'g': GoTop(); break;
+        case 'G': GoBottom(); break;
+        case ' ':
+        case 'f': PageDown(); break;
+        case 'b': PageUp(); break;
+        case 'j': ScrollBy(1); break;
+        case 'k': ScrollBy(-1); break;
+        default: break;
+    }
+}
+
+void Pager::Backspace() {
+    if (searching && !searchInput.empty()) {
+        searchInput.pop_back();
+    }
+}
+
+void Pager::Submit() {
+    if (searching) {
+        searching = false;
+        lastSearch = searchInput;
+        SearchForward(lastSearch, topLine + 1);
+        return;
+    }
+    ScrollBy(1);
+}
+
+void Pager::Cancel() {
+    if (searching) {
+        searching = false;
+        return;
+    }
+    Close();
+}
+
+int Pager::VisibleLineCount() const {
+    size_t indexed = lines->IndexedLines();
+    if (topLine >= indexed) return 0;
+    return static_cast<int>(std::min(indexed - topLine, static_cast<size_t>(pageLines)));
+}
+
+void Pager::GetStatusLine(FrameString& status) const {
+    if (searching) {
+        status.Append('/').Append(searchInput);
+        return;
+    }
+    if (!message.empty()) {
+        status.Append(message);
+        return;
+    }
+
+    size_t first = topLine + 1;
+    size_t last = topLine + VisibleLineCount();
+    status.Append(title).Append("  lines ").AppendInt(first).Append('-').AppendInt(last);
+    if (lines->IsComplete()) {
+        status.Append('/').AppendInt(lines->IndexedLines());
+        if (last >= lines->IndexedLines()) {
+            status.Append(" (END)");
+        }
+    }
+    status.Append("  [q]uit [/]search [n]ext [g/G]");
+}
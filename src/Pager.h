@@ -0,0 +1,55 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <string_view>
+#include "FrameArena.h"
+#include "LineIndex.h"
+
+// Full-screen `less` view over a file's LineIndex.
+//
+// Only the lines up to the bottom of the current page are indexed, so
+// opening a huge file shows the first page right away. Jumping to the
+// end or searching indexes further on demand.
+class Pager {
+private:
+    std::shared_ptr<LineIndex> lines;
+    std::string title;
+    size_t topLine = 0;
+    int pageLines = 16;
+    bool active = false;
+
+    // '/' search prompt
+    bool searching = false;
+    std::string searchInput;
+    std::string lastSearch;
+    std::string message;
+
+    void ClampTop();
+    void SearchForward(const std::string& query, size_t fromLine);
+
+public:
+    void Open(const std::string& name, std::shared_ptr<LineIndex> index);
+    void Close();
+    bool IsActive() const { return active; }
+
+    void SetPageLines(int count);
+    int GetPageLines() const { return pageLines; }
+
+    // Input
+    void HandleChar(int key);
+    void Backspace();
+    void Submit();
+    void Cancel();
+    void ScrollBy(int count);
+    void PageDown() { ScrollBy(pageLines); }
+    void PageUp() { ScrollBy(-pageLines); }
+    void GoTop();
+    void GoBottom();
+
+    // Rendering
+    size_t GetTopLine() const { return topLine; }
+    int VisibleLineCount() const;
+    std::string_view GetLine(size_t line) const { return lines->Line(line); }
+    const std::string& GetLastSearch() const { return lastSearch; }
+    void GetStatusLine(FrameString& status) const;
+};
@@ -1,4 +1,11 @@
 #include "PopupDialog.h"
+#include "TextCache.h"
+#include "TextMetrics.h"
+#include <algorithm>
+
+int PopupDialog::viewWidth = 800;
+int PopupDialog::viewHeight = 450;
+std::atomic<uint64_t> PopupDialog::lastVersion{0};
 
 PopupDialog::PopupDialog()
     : scrollPosition(0),
@@ -6,60 +13,37 @@ PopupDialog::PopupDialog()
       isVisible(false),
       padding(20),
       width(600),
-      height(400) {
-    // Center the dialog
-    x = (GetScreenWidth() - width) / 2;
-    y = (GetScreenHeight() - height) / 2;
+      height(400),
+      x(0),
+      y(0) {
+    Touch();
 }
 
-void PopupDialog::WrapText() {
-    lines.clear();
-    std::string currentLine;
-    std::string word;
-
-    for (char c : text) {
-        if (c == ' ' || c == '\n') {
-            if (MeasureText((currentLine + word).c_str(), 20) > width - (padding * 2)) {
-                lines.push_back(currentLine);
-                currentLine = word + " ";
-            } else {
-                currentLine += word + " ";
-            }
-            word = "";
-            if (c == '\n') {
-                lines.push_back(currentLine);
-                currentLine = "";
-            }
-        } else {
-            word += c;
-        }
-    }
-
-    if (!word.empty()) {
-        if (MeasureText((currentLine + word).c_str(), 20) > width - (padding * 2)) {
-            lines.push_back(currentLine);
-            lines.push_back(word);
-        } else {
-            lines.push_back(currentLine + word);
-        }
-    } else if (!currentLine.empty()) {
-        lines.push_back(currentLine);
-    }
+void PopupDialog::SetViewSize(int width, int height) {
+    viewWidth = width;
+    viewHeight = height;
 }
 
-void PopupDialog::Show(const std::string& message) {
-    text = message;
+void PopupDialog::Show(const std::string& message, float charsPerSecond) {
+    // 600x400 where it fits, keeping a margin in smaller views
+    width = std::min(600, viewWidth - 2 * padding);
+    height = std::min(400, viewHeight - 2 * padding);
+    x = (viewWidth - width) / 2;
+    y = (viewHeight - height) / 2;
+
     isVisible = true;
     scrollPosition = 0;
-    WrapText();
+    typer.Start(message, 20, width - (padding * 2), 25.0f, charsPerSecond);
+    Touch();
 }
 
 void PopupDialog::Hide() {
     isVisible = false;
+    Touch();
 }
 
-void PopupDialog::DrawScrollbar() {
-    float contentHeight = lines.size() * 25.0f;
+void PopupDialog::DrawScrollbar() const {
+    float contentHeight = typer.GetLayout().ContentHeight();
     if (contentHeight <= height - (padding * 2)) return;
 
     float scrollbarHeight = (height - (padding * 2)) * ((height - (padding * 2)) / contentHeight);
@@ -71,11 +55,39 @@ void PopupDialog::DrawScrollbar() {
     DrawRectangle(x + width - padding, scrollbarY, 10, scrollbarHeight, GREEN);
 }
 
-void PopupDialog::Update() {
+void PopupDialog::FollowCursor() {
+    // Keep the line being typed in view
+    float cursorBottom = (typer.GetCursorLine() + 1) * 25.0f;
+    scrollPosition = std::max(scrollPosition, cursorBottom - (height - (padding * 2)));
+}
+
+void PopupDialog::SkipTyping() {
+    typer.RevealAll();
+    FollowCursor();
+    Touch();
+}
+
+void PopupDialog::Tick(float step) {
+    if (!isVisible || typer.IsDone()) return;
+
+    size_t revealed = typer.GetRevealed();
+    typer.Update(step);
+    if (typer.GetRevealed() != revealed) {
+        FollowCursor();
+        Touch();
+    }
+}
+
+void PopupDialog::Update(InputQueue& input) {
     if (!isVisible) return;
 
-    float contentHeight = lines.size() * 25.0f;
+    float contentHeight = typer.GetLayout().ContentHeight();
     float maxScroll = contentHeight - (height - (padding * 2));
+    float scrolledFrom = scrollPosition;
+
+    if (!typer.IsDone() && (input.TakeKey(KEY_SPACE) || input.TakeKey(KEY_ENTER))) {
+        SkipTyping();
+    }
 
     if (contentHeight > height - (padding * 2)) {
         if (IsKeyDown(KEY_UP)) {
@@ -91,18 +103,21 @@ void PopupDialog::Update() {
                 scrollPosition - (wheel * 30.0f)));
         }
     }
+    if (scrollPosition != scrolledFrom) {
+        Touch();
+    }
 
-    if (IsKeyPressed(KEY_ESCAPE)) {
+    if (input.TakeKey(KEY_ESCAPE)) {
         restartRequested = true;
         Hide();
     }
 }
 
-void PopupDialog::Draw() {
+void PopupDialog::Draw() const {
     if (!isVisible) return;
 
     // Draw semi-transparent background
-    DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(), Color{0, 0, 0, 200});
+    DrawRectangle(0, 0, viewWidth, viewHeight, Color{0, 0, 0, 200});
 
     // Draw popup window
     DrawRectangle(x, y, width, height, BLACK);
@@ -111,13 +126,8 @@ void PopupDialog::Draw() {
     // Create scissor mode for text clipping
     BeginScissorMode(x + padding, y + padding, width - (padding * 2), height - (padding * 2));
 
-    // Draw text
-    for (size_t i = 0; i < lines.size(); i++) {
-        float lineY = y + padding + (i * 25.0f) - scrollPosition;
-        if (lineY >= y + padding - 25 && lineY <= y + height - padding) {
-            DrawText(lines[i].c_str(), x + padding, lineY, 20, GREEN);
-        }
-    }
+    // Only revealed lines inside the box are drawn
+    typer.Draw(x + padding, y + padding, scrollPosition, height - (padding * 2), GREEN);
 
     EndScissorMode();
 
@@ -125,9 +135,10 @@ void PopupDialog::Draw() {
     DrawScrollbar();
 
     // Draw instruction
-    DrawText("Use UP/DOWN arrows or mouse wheel to scroll",
-             x + padding, y + height - padding - 20, 15, Color{0, 255, 0, 150});
-    DrawText("Press ESC to restart",
-             x + width - padding - MeasureText("Press ESC to restart", 15),
-             y + height - padding - 20, 15, Color{0, 255, 0, 150});
+    TextCache& textCache = TextCache::Instance();
+    textCache.Draw("Use UP/DOWN arrows or mouse wheel to scroll",
+                   x + padding, y + height - padding - 20, 15, Color{0, 255, 0, 150});
+    textCache.Draw("Press ESC to restart",
+                   x + width - padding - TextMetrics::Instance().Measure("Press ESC to restart", 15),
+                   y + height - padding - 20, 15, Color{0, 255, 0, 150});
 }
@@ -1,11 +1,14 @@
 #pragma once
 #include <raylib.h>
+#include <atomic>
+#include <cstdint>
 #include <string>
-#include <vector>
+#include "InputQueue.h"
+#include "Typewriter.h"
 
 class PopupDialog {
 private:
-    std::string text;
+    Typewriter typer;
     float scrollPosition;
     float scrollSpeed;
     bool isVisible;
@@ -14,20 +17,35 @@ private:
     int height;
     int x;
     int y;
-    std::vector<std::string> lines;
 
-    void WrapText();
-    void DrawScrollbar();
+    // Size of the internal render target dialogs are centred in
+    static int viewWidth;
+    static int viewHeight;
+
+    void DrawScrollbar() const;
+    void FollowCursor();
 
     bool restartRequested = false;
 
+    // Bumped on every visible change, unique across dialogs
+    uint64_t version = 0;
+    static std::atomic<uint64_t> lastVersion;
+    void Touch() { version = ++lastVersion; }
+
 public:
     PopupDialog();
-    void Show(const std::string& message);
+    static void SetViewSize(int width, int height);
+    // charsPerSecond > 0 types the message out; SPACE/ENTER skip ahead.
+    // The dialog is sized and centred for the view when shown.
+    void Show(const std::string& message, float charsPerSecond = 0.0f);
     void Hide();
-    void Draw();
+    void Draw() const;
     bool IsVisible() const { return isVisible; }
-    void Update();
+    void Update(InputQueue& input);
+    void Tick(float step);  // Types on simulated time
+    void SkipTyping();      // Reveal the whole message
+    // A copy with the same version draws the same
+    uint64_t GetVersion() const { return version; }
 
     bool isRestartRequested() const { return restartRequested; }
     void clearRestartRequest() { restartRequested = false; }
@@ -0,0 +1,143 @@
+#include "ResourcePack.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #define NOGDI
+    #define NOUSER
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+ResourcePack& ResourcePack::Instance() {
+    static ResourcePack pack;
+    return pack;
+}
+
+ResourcePack::~ResourcePack() {
+    Close();
+}
+
+bool ResourcePack::Open(const std::string& path) {
+    Close();
+
+#if defined(_WIN32)
+    file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                       FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        file = nullptr;
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        Close();
+        return false;
+    }
+    mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        Close();
+        return false;
+    }
+    base = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        close(fd);
+        return false;
+    }
+    void* mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);   // The mapping keeps the file alive
+    if (mapped == MAP_FAILED) {
+        return false;
+    }
+    base = static_cast<const unsigned char*>(mapped);
+    size = static_cast<size_t>(info.st_size);
+#endif
+
+    if (!base || !Validate()) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+bool ResourcePack::Validate() {
+    if (size < sizeof(PackHeader)) return false;
+    header = reinterpret_cast<const PackHeader*>(base);
+    if (memcmp(header->magic, PACK_MAGIC, sizeof(PACK_MAGIC)) != 0 || header->version != PACK_VERSION) {
+        return false;
+    }
+
+    uint64_t indexEnd = header->indexOffset + (uint64_t)header->entryCount * sizeof(PackEntry);
+    uint64_t namesEnd = header->nameTableOffset + header->nameTableSize;
+    if (header->indexOffset % alignof(PackEntry) != 0 || indexEnd > size || namesEnd > size) {
+        return false;
+    }
+    entries = reinterpret_cast<const PackEntry*>(base + header->indexOffset);
+    names = reinterpret_cast<const char*>(base + header->nameTableOffset);
+
+    for (uint32_t i = 0; i < header->entryCount; i++) {
+        const PackEntry& entry = entries[i];
+        if ((uint64_t)entry.nameOffset + entry.nameLength > header->nameTableSize ||
+            entry.dataOffset + entry.dataSize + 1 > size) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ResourcePack::Close() {
+#if defined(_WIN32)
+    if (base) UnmapViewOfFile(base);
+    if (mapping) CloseHandle(mapping);
+    if (file) CloseHandle(file);
+    mapping = nullptr;
+    file = nullptr;
+#else
+    if (base) munmap(const_cast<unsigned char*>(base), size);
+#endif
+    base = nullptr;
+    size = 0;
+    header = nullptr;
+    entries = nullptr;
+    names = nullptr;
+}
+
+bool ResourcePack::Find(const std::string& name, const unsigned char** data, size_t* dataSize) const {
+    if (!base) return false;
+
+    // Binary search over the sorted index
+    size_t low = 0;
+    size_t high = header->entryCount;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        const PackEntry& entry = entries[mid];
+        size_t common = std::min<size_t>(entry.nameLength, name.size());
+        int order = memcmp(names + entry.nameOffset, name.data(), common);
+        if (order == 0) {
+            order = (entry.nameLength < name.size()) ? -1 : (entry.nameLength > name.size() ? 1 : 0);
+        }
+
+        if (order == 0) {
+            *data = base + entry.dataOffset;
+            *dataSize = static_cast<size_t>(entry.dataSize);
+            return true;
+        }
+        if (order < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return false;
+}
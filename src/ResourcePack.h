@@ -0,0 +1,70 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Single-file resource archive, memory-mapped at runtime.
+//
+// Layout (little endian):
+//   PackHeader
+//   PackEntry[entryCount]      sorted by name
+//   name table                 names are not NUL-terminated
+//   blobs                      each aligned to PACK_ALIGNMENT and followed
+//                              by a zero byte, so text can be used in place
+//
+// Built by the resource_packer tool (tools/ResourcePacker.cpp). Nothing
+// here depends on raylib, so the tool can share it.
+
+static const char PACK_MAGIC[4] = {'T', 'I', 'P', 'K'};
+static const uint32_t PACK_VERSION = 1;
+static const uint64_t PACK_ALIGNMENT = 64;
+
+struct PackHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t nameTableSize;
+    uint64_t indexOffset;
+    uint64_t nameTableOffset;
+};
+
+struct PackEntry {
+    uint32_t nameOffset;     // Into the name table
+    uint32_t nameLength;
+    uint64_t dataOffset;     // From the start of the file
+    uint64_t dataSize;       // Excluding the trailing zero byte
+};
+
+class ResourcePack {
+private:
+    const unsigned char* base = nullptr;
+    size_t size = 0;
+    const PackHeader* header = nullptr;
+    const PackEntry* entries = nullptr;
+    const char* names = nullptr;
+
+#if defined(_WIN32)
+    void* file = nullptr;
+    void* mapping = nullptr;
+#endif
+
+    bool Validate();
+
+public:
+    ResourcePack() = default;
+    ~ResourcePack();
+    ResourcePack(const ResourcePack&) = delete;
+    ResourcePack& operator=(const ResourcePack&) = delete;
+
+    // The game's archive; opened by the asset code on first use
+    static ResourcePack& Instance();
+
+    // Maps the whole file read-only; false if it is missing or malformed
+    bool Open(const std::string& path);
+    void Close();
+    bool IsOpen() const { return base != nullptr; }
+    int GetEntryCount() const { return header ? (int)header->entryCount : 0; }
+
+    // Points into the mapping, valid until Close(); names use '/'
+    bool Find(const std::string& name, const unsigned char** data, size_t* dataSize) const;
+};
@@ -0,0 +1,53 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "AssetLoader.h"
+
+enum class SceneId {
+    NONE,
+    START,
+    BRIEF,
+    DESCENT,
+    BOOT,
+    TERMINAL,
+    BREACH_LOADING,
+    BREACH
+};
+
+struct AssetRequest {
+    AssetType type;
+    std::string path;
+};
+
+// One screen of the game, run by the SceneStack.
+//
+// Update() runs once per rendered frame and handles input and any work
+// that needs to happen outside the scene's texture pass (such as rendering
+// into other textures). Tick() advances the simulation by a fixed step and
+// runs zero or more times per frame, so timers, typing and animations
+// behave the same at any frame rate. Draw() renders into the scene target,
+// blending the last two steps by Game::GetFrameAlpha() where motion would
+// otherwise judder. Only the top scene of the stack runs.
+class Scene {
+public:
+    virtual ~Scene() {}
+
+    virtual SceneId GetId() const = 0;
+
+    // Assets the scene uses; they are requested as soon as the scene is
+    // expected to come up, so they load while the previous one plays
+    virtual void DeclareAssets(std::vector<AssetRequest>& assets) const {}
+
+    // Scene that normally follows this one, whose assets are preloaded
+    // when this one is entered
+    virtual SceneId GetNextScene() const { return SceneId::NONE; }
+
+    virtual void Enter() {}
+    virtual void Update(float dt) {}
+    virtual void Tick(float step) {}
+    virtual void Draw() = 0;
+    virtual void Exit() {}
+
+    // False when nothing on screen is moving, which allows idle throttling
+    virtual bool IsAnimating() const { return true; }
+};
@@ -0,0 +1,86 @@
+#include "SceneStack.h"
+
+SceneStack::SceneStack(Factory factory, AssetLoader& assets)
+    : factory(std::move(factory)), assets(assets) {}
+
+SceneStack::~SceneStack() {
+    Clear();
+}
+
+std::unique_ptr<Scene> SceneStack::Create(SceneId id) {
+    if (prepared && prepared->GetId() == id) {
+        return std::move(prepared);
+    }
+    std::unique_ptr<Scene> scene = factory(id);
+    if (scene) {
+        RequestAssets(*scene);
+    }
+    return scene;
+}
+
+void SceneStack::RequestAssets(const Scene& scene) {
+    std::vector<AssetRequest> requests;
+    scene.DeclareAssets(requests);
+    for (const AssetRequest& request : requests) {
+        assets.Request(request.type, request.path);
+    }
+}
+
+void SceneStack::Enter(std::unique_ptr<Scene> scene) {
+    if (!scene) {
+        return;
+    }
+    scenes.push_back(std::move(scene));
+    scenes.back()->Enter();
+
+    // Start loading whatever comes next while this scene plays
+    SceneId next = scenes.back()->GetNextScene();
+    if (next != SceneId::NONE && (!prepared || prepared->GetId() != next)) {
+        prepared = factory(next);
+        if (prepared) {
+            RequestAssets(*prepared);
+        }
+    }
+}
+
+void SceneStack::ExitTop() {
+    if (scenes.empty()) {
+        return;
+    }
+    scenes.back()->Exit();
+    scenes.pop_back();
+}
+
+void SceneStack::ApplyChanges() {
+    // Changes made by Enter() or Exit() are applied in the same pass
+    for (size_t i = 0; i < changes.size(); i++) {
+        Change change = changes[i];
+        switch (change.op) {
+            case Op::PUSH:
+                Enter(Create(change.id));
+                break;
+            case Op::POP:
+                ExitTop();
+                break;
+            case Op::REPLACE:
+                ExitTop();
+                Enter(Create(change.id));
+                break;
+            case Op::RESET:
+                while (!scenes.empty()) {
+                    ExitTop();
+                }
+                Enter(Create(change.id));
+                break;
+        }
+    }
+    changes.clear();
+}
+
+void SceneStack::Clear() {
+    while (!scenes.empty()) {
+        ExitTop();
+    }
+    changes.clear();
+    prepared.reset();
+}
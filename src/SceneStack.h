@@ -0,0 +1,58 @@
+#pragma once
+#include <functional>
+#include <memory>
+#include <vector>
+#include "Scene.h"
+#include "AssetLoader.h"
+
+// Stack of scenes; the top one is updated and drawn.
+//
+// Changes requested during a frame are applied by ApplyChanges() once the
+// frame is done, so a scene never destroys itself mid-update. Entering a
+// scene also prepares the scene expected to follow it and requests its
+// assets, which is what lets transitions happen without a loading stall.
+class SceneStack {
+public:
+    using Factory = std::function<std::unique_ptr<Scene>(SceneId)>;
+
+private:
+    enum class Op {
+        PUSH,
+        POP,
+        REPLACE,
+        RESET
+    };
+
+    struct Change {
+        Op op;
+        SceneId id;
+    };
+
+    Factory factory;
+    AssetLoader& assets;
+    std::vector<std::unique_ptr<Scene>> scenes;
+    std::vector<Change> changes;
+    std::unique_ptr<Scene> prepared;   // Expected next scene, assets requested
+
+    std::unique_ptr<Scene> Create(SceneId id);
+    void RequestAssets(const Scene& scene);
+    void Enter(std::unique_ptr<Scene> scene);
+    void ExitTop();
+
+public:
+    SceneStack(Factory factory, AssetLoader& assets);
+    ~SceneStack();
+    SceneStack(const SceneStack&) = delete;
+    SceneStack& operator=(const SceneStack&) = delete;
+
+    void Push(SceneId id) { changes.push_back({Op::PUSH, id}); }
+    void Pop() { changes.push_back({Op::POP, SceneId::NONE}); }
+    void Replace(SceneId id) { changes.push_back({Op::REPLACE, id}); }
+    void Reset(SceneId id) { changes.push_back({Op::RESET, id}); }
+
+    void ApplyChanges();
+    void Clear();
+
+    Scene* Top() const { return scenes.empty() ? nullptr : scenes.back().get(); }
+    bool IsEmpty() const { return scenes.empty(); }
+};
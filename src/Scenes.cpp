@@ -0,0 +1,384 @@
+#include "Scenes.h"
+#include "Game.h"
+#include "FrameArena.h"
+#include "TextMetrics.h"
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+static const char* menuMusicPath = "music/Cypher.mp3";
+static const char* floppySoundPath = "sound/floppySound.wav";
+
+static const char* typingSoundPaths[] = {
+    "sound/keypress27.wav",
+    "sound/keypress28.wav",
+    "sound/keypress29.wav",
+    "sound/keypress30.wav"
+};
+
+// Indexed by the boot timeline's sound cues
+static const char* retroPCSoundPaths[] = {
+    "sound/retroPCButtonPressed.wav",
+    "sound/retroPCBootUpSeq.wav"
+};
+
+static const char* missionText =
+    "*================================== CLASSIFIED ===================================*\n"
+    "|                                      OPERATION: NULL PTR                                        |\n"
+    "|                                   CLEARANCE LEVEL: OMEGA                                     | \n"
+    "*====================================================================================*\n\n"
+    "MISSION BRIEF:\n"
+    "Intelligence has identified a high-priority target system containing\n"
+    "classified access codes. Your mission is to infiltrate and extract\n"
+    "the required data without detection.\n\n"
+    "OBJECTIVES:\n"
+    "- Gain access to the target system\n"
+    "- Navigate through security measures\n"
+    "- Locate and retrieve NUCLEAR LAUNCH CODES\n"
+    "- Extract without leaving traces\n\n"
+    "CRITICAL NOTES:\n"
+    "- Security systems are active and monitoring\n"
+    "- Detection will result in immediate mission failure\n"
+    "- Time is of the essence\n\n"
+    "EXFILTRATION REQUIREMENTS:\n"
+    "Retrieve NUCLEAR launch codes from alliance network infrastructure \n\n"
+    "STATUS: ACTIVE - COMMENCE OPERATION\n";
+
+static const float missionTypeSpeed = 20.0f;   // Characters per second
+
+// Start
+
+void StartScene::DeclareAssets(std::vector<AssetRequest>& assets) const {
+    assets.push_back({AssetType::MUSIC, menuMusicPath});
+}
+
+void StartScene::Enter() {
+    game.PlayMusic(menuMusicPath, 0.35f);
+}
+
+void StartScene::Update(float dt) {
+    if (game.input.TakeAnyKey()) {
+        game.scenes.Replace(SceneId::BRIEF);
+    }
+}
+
+void StartScene::Draw() {
+    const char* title = "Terminal Infiltrator";
+    const char* promptText = "Press any key to start";
+
+    int titleWidth = TextMetrics::Instance().Measure(title, 40);
+    int promptWidth = TextMetrics::Instance().Measure(promptText, 20);
+
+    DrawText(title, (game.screenWidth - titleWidth) / 2, game.screenHeight / 2 - 50, 40, GREEN);
+    DrawText(promptText, (game.screenWidth - promptWidth) / 2, game.screenHeight / 2 + 10, 20, GREEN);
+}
+
+// Mission brief
+
+void BriefScene::DeclareAssets(std::vector<AssetRequest>& assets) const {
+    for (const char* path : typingSoundPaths) {
+        assets.push_back({AssetType::SOUND, path});
+    }
+}
+
+void BriefScene::Enter() {
+    textY = game.screenHeight / 4;
+    boxWidth = game.screenWidth - 2 * (textX - boxPadding);
+    int boxHeight = game.screenHeight - 2 * (textY - boxPadding);
+    int reservedPromptSpace = 40;
+    textAreaHeight = boxHeight - reservedPromptSpace;
+    visibleLines = (textAreaHeight / lineHeight);
+
+    // Typewriter effect: laid out once, then revealed at about 20 chars/s
+    typer.Start(missionText, 18, boxWidth - 2 * boxPadding, lineHeight, missionTypeSpeed);
+}
+
+void BriefScene::Update(float dt) {
+    if (typer.IsDone() && game.input.TakeKey(KEY_SPACE)) {
+        game.scenes.Replace(SceneId::DESCENT);
+    }
+}
+
+void BriefScene::Tick(float step) {
+    if (typer.Update(step) > 0 && !typer.IsDone()) {
+        game.PlaySoundAsset(typingSoundPaths[GetRandomValue(0, 3)], SoundBus::TYPING, SoundPriority::LOW);
+    }
+
+    previousFlash = flashCounter;
+    if (typer.IsDone()) {
+        flashCounter += step * 6.0f;
+    }
+}
+
+void BriefScene::Draw() {
+    int boxHeight = game.screenHeight - 2 * (textY - boxPadding);
+    DrawRectangle(textX - boxPadding, textY - boxPadding, boxWidth, boxHeight, Color{0, 20, 0, 50});
+
+    BeginScissorMode(textX - boxPadding, textY - boxPadding, boxWidth, textAreaHeight);
+
+    // Scanlines, CRT rows, distortion and glitch come from the CRT pass
+    game.SetCrtArea(Rectangle{(float)(textX - boxPadding), (float)(textY - boxPadding),
+                              (float)boxWidth, (float)textAreaHeight},
+                    lineHeight, 4, lineHeight * 2, 2);
+
+    int lineCount = static_cast<int>(typer.GetCursorLine());
+    int scrollOffset = 0;
+    if (lineCount > visibleLines) {
+        scrollOffset = (lineCount - visibleLines + 1) * lineHeight;
+    }
+
+    typer.Draw(textX, textY, (float)scrollOffset, (float)textAreaHeight, GREEN);
+
+    EndScissorMode();
+
+    if (typer.IsDone()) {
+        const char* continueText = "[ MISSION START: SPACE_BAR ]";
+        int continueWidth = TextMetrics::Instance().Measure(continueText, 20);
+
+        float flash = previousFlash + (flashCounter - previousFlash) * game.GetFrameAlpha();
+        float alpha = (sin(flash) + 1.0f) * 0.5f;
+        Color flashColor = Color{150, 255, 150, static_cast<unsigned char>(255 * alpha)};
+
+        DrawText(continueText,
+                 (game.screenWidth - continueWidth) / 2,
+                 textY + textAreaHeight - 10,
+                 20,
+                 flashColor);
+    }
+}
+
+// Cutscenes
+
+CutsceneScene::CutsceneScene(Game& game, SceneId id, const char* timeline, SceneId next)
+    : game(game), id(id), next(next) {
+    cutscene.Load(timeline);
+}
+
+void CutsceneScene::DeclareAssets(std::vector<AssetRequest>& assets) const {
+    cutscene.DeclareAssets(assets);
+}
+
+void CutsceneScene::Enter() {
+    cutscene.Start(game.assets);
+}
+
+void CutsceneScene::Exit() {
+    cutscene.Stop();
+}
+
+void CutsceneScene::Update(float dt) {
+    // Space skips ahead at any point; the next scene takes over the audio
+    if (game.input.TakeKey(KEY_SPACE) || cutscene.IsFinished()) {
+        game.scenes.Replace(next);
+    }
+}
+
+void CutsceneScene::Tick(float step) {
+    cutscene.Update(step);
+    while (const std::string* cue = cutscene.NextCue()) {
+        game.PlaySoundAsset(*cue, SoundBus::EFFECTS, SoundPriority::NORMAL);
+    }
+}
+
+void CutsceneScene::Draw() {
+    DrawRectangle(0, 0, game.screenWidth, game.screenHeight, Color{0, 20, 0, 50});
+
+    // Artwork area: screen less the padding and a strip for captions
+    const int padding = 20;
+    float frameWidth = game.screenWidth - 2 * padding;
+    float frameHeight = game.screenHeight - 100 - 2 * padding;
+    Rectangle frame = {(float)padding, game.screenHeight / 2 - 20 - frameHeight / 2, frameWidth, frameHeight};
+
+    Rectangle crtArea = { 0 };
+    cutscene.Draw(frame, game.screenWidth, game.screenHeight, game.GetFrameAlpha(), crtArea);
+
+    const Cutscene::CrtEffect& crt = cutscene.GetCrtEffect();
+    if (crt.enabled && crtArea.width > 0) {
+        game.SetCrtArea(crtArea, crt.scanlineSpacing, crt.darkLineSpacing, crt.distortionSpacing, crt.glitchChance);
+    }
+}
+
+// Boot
+
+// Boot screen script: (time, action, text, value), sorted by time.
+// Times are seconds since the scene started; the power-on sweep covers
+// the first half second, so lines printed at 0 appear once it ends.
+static const BootSequence::Event bootTimeline[] = {
+    {0.0f, BootSequence::Action::SOUND, nullptr, 1},
+    {0.0f, BootSequence::Action::PRINT, "SCO UNIX System V/386 Release 3.2", 0},
+    {0.0f, BootSequence::Action::PRINT, "", 0},
+    {0.0f, BootSequence::Action::PRINT, "CPU Type: i486DX", 0},
+    {0.0f, BootSequence::Action::PRINT, "Clock Speed: 66 MHz", 0},
+    {0.0f, BootSequence::Action::PRINT, "", 0},
+    {0.0f, BootSequence::Action::PRINT, "Performing memory test...", 0},
+    {0.0f, BootSequence::Action::PRINT, "Memory Test:     ", 0},
+    {2.0f, BootSequence::Action::PROGRESS, "Memory Test: %d%%", 4.0f},
+    {6.0f, BootSequence::Action::PRINT, "", 0},
+    {6.0f, BootSequence::Action::PRINT, "Memory Configuration:", 0},
+    {6.0f, BootSequence::Action::PRINT, "Base Memory:    640K", 0},
+    {6.0f, BootSequence::Action::PRINT, "Extended:      7168K", 0},
+    {6.0f, BootSequence::Action::PRINT, "Cache:          256K", 0},
+    {6.25f, BootSequence::Action::PRINT, "Total Memory:   8064K", 0},
+    {6.7f, BootSequence::Action::PRINT, "", 0},
+    {7.15f, BootSequence::Action::PRINT, "Hardware Detection:", 0},
+    {7.6f, BootSequence::Action::PRINT, "Serial Port (tty0).........Detected", 0},
+    {8.05f, BootSequence::Action::PRINT, "Serial Port (tty1).........Detected", 0},
+    {8.5f, BootSequence::Action::PRINT, "Parallel Port (lp0)........Detected", 0},
+    {8.95f, BootSequence::Action::PRINT, "", 0},
+    {9.4f, BootSequence::Action::PRINT, "Initializing File Systems...", 0},
+    {9.85f, BootSequence::Action::PRINT, "Checking root filesystem...", 0},
+    {10.3f, BootSequence::Action::PRINT, "/ ...........................OK", 0},
+    {10.75f, BootSequence::Action::PRINT, "/usr ........................OK", 0},
+    {11.2f, BootSequence::Action::PRINT, "/var ........................OK", 0},
+    {11.65f, BootSequence::Action::PRINT, "", 0},
+    {12.1f, BootSequence::Action::PRINT, "Starting UNIX services:", 0},
+    {12.55f, BootSequence::Action::PRINT, "syslogd ................. Running", 0},
+    {13.0f, BootSequence::Action::PRINT, "inetd ................... Running", 0},
+    {13.45f, BootSequence::Action::PRINT, "cron .................... Running", 0},
+    {13.9f, BootSequence::Action::PRINT, "", 0},
+    {14.35f, BootSequence::Action::PRINT, "INIT: Entering runlevel 3", 0},
+    {14.8f, BootSequence::Action::PRINT, "", 0},
+    {15.25f, BootSequence::Action::PRINT, "Unix System V Release 3.2", 0},
+    {15.7f, BootSequence::Action::PRINT, "login: _", 0},
+    {16.0f, BootSequence::Action::END, nullptr, 0},
+};
+
+void BootScene::DeclareAssets(std::vector<AssetRequest>& assets) const {
+    for (const char* path : retroPCSoundPaths) {
+        assets.push_back({AssetType::SOUND, path});
+    }
+}
+
+void BootScene::Enter() {
+    game.StopMusic();
+    sequence.Start(bootTimeline, sizeof(bootTimeline) / sizeof(bootTimeline[0]));
+}
+
+void BootScene::Update(float dt) {
+    // The terminal is built during startup, long before the boot ends
+    if (sequence.IsFinished() && game.IsTerminalReady()) {
+        game.scenes.Replace(SceneId::TERMINAL);
+    }
+}
+
+void BootScene::Tick(float step) {
+    previousTime = sequence.GetTime();
+    int cue = sequence.Update(step);
+    if (cue >= 0 && cue < 2) {
+        // Cue 0 is the power button, cue 1 the long boot-up sequence
+        SoundBus bus = (cue == 0) ? SoundBus::UI : SoundBus::EFFECTS;
+        game.PlaySoundAsset(retroPCSoundPaths[cue], bus, SoundPriority::HIGH);
+    }
+}
+
+void BootScene::Draw() {
+    const int padding = 20;
+    int terminalWidth = game.screenWidth - 2 * padding;
+    int terminalHeight = game.screenHeight - 2 * padding;
+    const float powerOnDuration = 0.5f;
+
+    DrawRectangle(0, 0, game.screenWidth, game.screenHeight, Color{0, 20, 0, 50});
+
+    float time = previousTime + (sequence.GetTime() - previousTime) * game.GetFrameAlpha();
+    if (time < powerOnDuration) {
+        float powerOnEffect = time / powerOnDuration;
+        int linePos = game.screenHeight * (1.0f - powerOnEffect);
+        DrawRectangle(0, linePos, game.screenWidth, 4, Color{0, 255, 0, 180});
+        return;
+    }
+
+    DrawRectangleRounded(
+        Rectangle{(float)padding, (float)padding,
+                  (float)terminalWidth, (float)terminalHeight},
+        0.1f,
+        20,
+        Color{0, 40, 0, 100}
+    );
+
+    BeginScissorMode(padding, padding, terminalWidth, terminalHeight);
+
+    game.SetCrtArea(Rectangle{(float)padding, (float)padding, (float)terminalWidth, (float)terminalHeight}, 20, 4, 40, 3);
+
+    int lineHeight = 25;
+    int visibleLines = (terminalHeight - padding) / lineHeight;
+
+    int totalLines = sequence.GetLineCount();
+    int scrollOffset = 0;
+    if (totalLines > visibleLines) {
+        scrollOffset = (totalLines - visibleLines + 1) * lineHeight;
+    }
+
+    // Only lines inside the window are drawn
+    int first = std::max(sequence.GetFirstLine(), (padding - 40 + scrollOffset + lineHeight - 1) / lineHeight);
+    for (int i = first; i < totalLines; i++) {
+        int yPos = 40 + i * lineHeight - scrollOffset;
+        if (yPos >= terminalHeight) break;
+        DrawText(sequence.GetLine(i), 40, yPos, 20, GREEN);
+    }
+
+    EndScissorMode();
+}
+
+// Breach protocol
+
+void BreachLoadingScene::DeclareAssets(std::vector<AssetRequest>& assets) const {
+    assets.push_back({AssetType::SOUND, floppySoundPath});
+}
+
+void BreachLoadingScene::Enter() {
+    game.PlaySoundAsset(floppySoundPath, SoundBus::EFFECTS, SoundPriority::HIGH);
+}
+
+void BreachLoadingScene::Update(float dt) {
+    // Once per frame: several ticks can expire the timer in one frame
+    if (timer <= 0) {
+        game.scenes.Replace(SceneId::BREACH);
+    }
+}
+
+void BreachLoadingScene::Tick(float step) {
+    loadingAnim += step * 4.0f;
+    timer -= step;
+}
+
+void BreachLoadingScene::Draw() {
+    const int padding = 20;
+    int windowWidth = game.screenWidth - 2 * padding;
+    int windowHeight = game.screenHeight - 2 * padding;
+
+    DrawRectangle(padding, padding, windowWidth, windowHeight, Color{0, 20, 0, 50});
+    DrawRectangleLines(padding, padding, windowWidth, windowHeight, GREEN);
+
+    const char* loadingText = "LOADING BREACH PROTOCOL";
+    FrameString text;
+    text.Append(loadingText).Append('.', (int)loadingAnim % 4);
+
+    DrawText(text.CStr(),
+             game.screenWidth/2 - TextMetrics::Instance().Measure(loadingText, 30)/2,
+             game.screenHeight/2, 30, GREEN);
+}
+
+void BreachScene::Enter() {
+    game.simulation.StartBreach();
+    breachResults = game.View().breachResults;
+}
+
+void BreachScene::Update(float dt) {
+    // The minigame runs on the simulation thread, which also applies the
+    // outcome to the terminal; the scene only forwards clicks
+    if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
+        game.simulation.SendClick(GetMousePosition());
+    }
+    if (game.View().breachResults != breachResults) {
+        game.scenes.Pop();
+    }
+}
+
+void BreachScene::Draw() {
+    const SimulationSnapshot& view = game.View();
+    if (view.breach) {
+        view.breach->draw(view.breachTimeLeft);
+    }
+    DrawText(TextFormat("ATTEMPTS REMAINING: %d", view.breachAttempts),
+            10, game.screenHeight - 30, 20, GREEN);
+}
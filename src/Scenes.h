@@ -0,0 +1,121 @@
+#pragma once
+#include <raylib.h>
+#include "Scene.h"
+#include "BootSequence.h"
+#include "Cutscene.h"
+#include "Typewriter.h"
+
+class Game;
+
+// Title screen; any key starts the mission brief
+class StartScene : public Scene {
+private:
+    Game& game;
+
+public:
+    explicit StartScene(Game& game) : game(game) {}
+    SceneId GetId() const override { return SceneId::START; }
+    void DeclareAssets(std::vector<AssetRequest>& assets) const override;
+    SceneId GetNextScene() const override { return SceneId::BRIEF; }
+    void Enter() override;
+    void Update(float dt) override;
+    void Draw() override;
+};
+
+// Mission brief typed out with key sounds
+class BriefScene : public Scene {
+private:
+    Game& game;
+    Typewriter typer;
+    float flashCounter = 0.0f;
+    float previousFlash = 0.0f;
+
+    // Layout
+    int textX = 50;
+    int textY = 0;
+    int boxPadding = 10;
+    int lineHeight = 20;
+    int boxWidth = 0;
+    int textAreaHeight = 0;
+    int visibleLines = 0;
+
+public:
+    explicit BriefScene(Game& game) : game(game) {}
+    SceneId GetId() const override { return SceneId::BRIEF; }
+    void DeclareAssets(std::vector<AssetRequest>& assets) const override;
+    SceneId GetNextScene() const override { return SceneId::DESCENT; }
+    void Enter() override;
+    void Update(float dt) override;
+    void Tick(float step) override;
+    void Draw() override;
+};
+
+// Plays a cutscene timeline; SPACE continues to the next scene
+class CutsceneScene : public Scene {
+private:
+    Game& game;
+    SceneId id;
+    SceneId next;
+    Cutscene cutscene;
+
+public:
+    CutsceneScene(Game& game, SceneId id, const char* timeline, SceneId next);
+    SceneId GetId() const override { return id; }
+    void DeclareAssets(std::vector<AssetRequest>& assets) const override;
+    SceneId GetNextScene() const override { return next; }
+    void Enter() override;
+    void Update(float dt) override;
+    void Tick(float step) override;
+    void Draw() override;
+    void Exit() override;
+};
+
+// Power-on sweep and boot log, played from a timeline
+class BootScene : public Scene {
+private:
+    Game& game;
+    BootSequence sequence;
+    float previousTime = 0.0f;   // Sequence time at the previous step
+
+public:
+    explicit BootScene(Game& game) : game(game) {}
+    SceneId GetId() const override { return SceneId::BOOT; }
+    void DeclareAssets(std::vector<AssetRequest>& assets) const override;
+    SceneId GetNextScene() const override { return SceneId::TERMINAL; }
+    void Enter() override;
+    void Update(float dt) override;
+    void Tick(float step) override;
+    void Draw() override;
+};
+
+// Short loading screen pushed over the terminal before the minigame
+class BreachLoadingScene : public Scene {
+private:
+    Game& game;
+    float timer = 2.0f;
+    float loadingAnim = 0.0f;
+
+public:
+    explicit BreachLoadingScene(Game& game) : game(game) {}
+    SceneId GetId() const override { return SceneId::BREACH_LOADING; }
+    void DeclareAssets(std::vector<AssetRequest>& assets) const override;
+    SceneId GetNextScene() const override { return SceneId::BREACH; }
+    void Enter() override;
+    void Update(float dt) override;
+    void Tick(float step) override;
+    void Draw() override;
+};
+
+// Breach protocol minigame; pops back to the terminal when it ends
+class BreachScene : public Scene {
+private:
+    Game& game;
+    unsigned breachResults = 0;   // Count when the breach started
+
+public:
+    explicit BreachScene(Game& game) : game(game) {}
+    SceneId GetId() const override { return SceneId::BREACH; }
+    void Enter() override;
+    void Update(float dt) override;
+    void Draw() override;
+};
@@ -0,0 +1,44 @@
+#include "Scrollback.h"
+#include <algorithm>
+
+void Scrollback::push_back(const std::string& line) {
+    if (blocks.empty() || blocks.back().view) {
+        blocks.emplace_back();
+        blockStarts.push_back(total);
+    }
+    Block& block = blocks.back();
+    block.lines.push_back(line);
+    block.count++;
+    total++;
+}
+
+void Scrollback::PushView(std::shared_ptr<LineIndex> index, size_t first, size_t count) {
+    if (count == 0) {
+        return;
+    }
+    index->IndexThrough(first + count - 1);
+
+    Block block;
+    block.view = std::move(index);
+    block.first = first;
+    block.count = count;
+    blocks.push_back(std::move(block));
+    blockStarts.push_back(total);
+    total += count;
+}
+
+void Scrollback::clear() {
+    blocks.clear();
+    blockStarts.clear();
+    total = 0;
+}
+
+std::string_view Scrollback::operator[](size_t line) const {
+    size_t blockNum = std::upper_bound(blockStarts.begin(), blockStarts.end(), line) - blockStarts.begin() - 1;
+    const Block& block = blocks[blockNum];
+    size_t offset = line - blockStarts[blockNum];
+    if (block.view) {
+        return block.view->Line(block.first + offset);
+    }
+    return block.lines[offset];
+}
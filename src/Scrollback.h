@@ -0,0 +1,36 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "LineIndex.h"
+
+// Terminal output lines.
+//
+// Ordinary messages are owned strings. Large file output is stored as a
+// single block that points at a range of lines in a LineIndex, so
+// catting a file costs one block plus the (cached) index instead of a
+// copy of every line.
+class Scrollback {
+private:
+    struct Block {
+        std::shared_ptr<LineIndex> view;  // null for owned lines
+        size_t first = 0;
+        size_t count = 0;
+        std::vector<std::string> lines;
+    };
+
+    std::vector<Block> blocks;
+    std::vector<size_t> blockStarts;
+    size_t total = 0;
+
+public:
+    // Container-style names so call sites read like the vector they replace
+    void push_back(const std::string& line);
+    void PushView(std::shared_ptr<LineIndex> index, size_t first, size_t count);
+    void clear();
+
+    size_t size() const { return total; }
+    bool empty() const { return total == 0; }
+    std::string_view operator[](size_t line) const;
+};
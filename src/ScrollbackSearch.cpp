@@ -0,0 +1,107 @@
+#include "ScrollbackSearch.h"
+#include <algorithm>
+
+static const std::string emptyQuery;
+
+void ScrollbackSearch::Start() {
+    active = true;
+    levels.clear();
+    current = -1;
+}
+
+void ScrollbackSearch::Stop() {
+    active = false;
+    levels.clear();
+    current = -1;
+}
+
+void ScrollbackSearch::AppendChar(char c, const Scrollback& lines) {
+    Level next;
+    if (levels.empty()) {
+        next.query = std::string(1, c);
+    } else {
+        // Anything matching the longer query also matched the shorter one,
+        // so only the parent's matches need checking
+        const Level& prev = levels.back();
+        next.query = prev.query + c;
+        next.scannedTo = prev.scannedTo;
+        for (uint32_t line : prev.matches) {
+            if (lines[line].find(next.query) != std::string_view::npos) {
+                next.matches.push_back(line);
+            }
+        }
+    }
+    levels.push_back(std::move(next));
+    current = levels.back().matches.empty() ? -1 : static_cast<int>(levels.back().matches.size()) - 1;
+}
+
+void ScrollbackSearch::Backspace() {
+    if (!levels.empty()) {
+        levels.pop_back();
+    }
+    current = MatchCount() > 0 ? static_cast<int>(MatchCount()) - 1 : -1;
+}
+
+void ScrollbackSearch::Invalidate() {
+    for (Level& level : levels) {
+        level.matches.clear();
+        level.scannedTo = 0;
+    }
+    current = -1;
+}
+
+void ScrollbackSearch::Update(const Scrollback& lines) {
+    if (!active || levels.empty()) {
+        return;
+    }
+
+    Level& level = levels.back();
+    size_t end = std::min(lines.size(), level.scannedTo + scanBudget);
+    for (size_t i = level.scannedTo; i < end; i++) {
+        if (lines[i].find(level.query) != std::string_view::npos) {
+            level.matches.push_back(static_cast<uint32_t>(i));
+        }
+    }
+    level.scannedTo = end;
+
+    if (current < 0 && !level.matches.empty()) {
+        current = static_cast<int>(level.matches.size()) - 1;
+    }
+}
+
+bool ScrollbackSearch::IsScanning(const Scrollback& lines) const {
+    return active && !levels.empty() && levels.back().scannedTo < lines.size();
+}
+
+const std::string& ScrollbackSearch::GetQuery() const {
+    return levels.empty() ? emptyQuery : levels.back().query;
+}
+
+size_t ScrollbackSearch::MatchCount() const {
+    return levels.empty() ? 0 : levels.back().matches.size();
+}
+
+long ScrollbackSearch::CurrentLine() const {
+    if (levels.empty() || current < 0 || current >= static_cast<int>(levels.back().matches.size())) {
+        return -1;
+    }
+    return levels.back().matches[current];
+}
+
+bool ScrollbackSearch::IsMatchLine(size_t line) const {
+    if (levels.empty()) return false;
+    const std::vector<uint32_t>& matches = levels.back().matches;
+    return std::binary_search(matches.begin(), matches.end(), static_cast<uint32_t>(line));
+}
+
+bool ScrollbackSearch::Previous() {
+    if (current <= 0) return false;
+    current--;
+    return true;
+}
+
+bool ScrollbackSearch::Next() {
+    if (current < 0 || current + 1 >= static_cast<int>(MatchCount())) return false;
+    current++;
+    return true;
+}
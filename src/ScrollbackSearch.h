@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Scrollback.h"
+
+// Incremental search over terminal scrollback (CTRL+F).
+//
+// Each typed character pushes a level whose matches are filtered from the
+// previous level's, so refining a query never rescans the scrollback;
+// backspace pops back to the earlier level. Lines appended after a level
+// was built are picked up by Update(), a bounded number per frame.
+class ScrollbackSearch {
+private:
+    struct Level {
+        std::string query;
+        std::vector<uint32_t> matches;  // Ascending line numbers
+        size_t scannedTo = 0;
+    };
+
+    // Lines examined per Update() call
+    static const size_t scanBudget = 20000;
+
+    std::vector<Level> levels;
+    bool active = false;
+    int current = -1;  // Index into the top level's matches
+
+public:
+    void Start();
+    void Stop();
+    bool IsActive() const { return active; }
+
+    void AppendChar(char c, const Scrollback& lines);
+    void Backspace();
+    void Invalidate();  // Scrollback was cleared
+
+    // Scan lines appended since the last call
+    void Update(const Scrollback& lines);
+    bool IsScanning(const Scrollback& lines) const;
+
+    const std::string& GetQuery() const;
+    size_t MatchCount() const;
+    int CurrentIndex() const { return current; }
+    long CurrentLine() const;
+    bool IsMatchLine(size_t line) const;
+
+    // Older / newer match; returns false when there is none
+    bool Previous();
+    bool Next();
+};
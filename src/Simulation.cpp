@@ -0,0 +1,329 @@
+#include "Simulation.h"
+#include <algorithm>
+#include <chrono>
+
+Simulation::Simulation(int screenWidth, int screenHeight)
+    : screenWidth(screenWidth),
+      screenHeight(screenHeight),
+      terminal(nullptr) {
+    pending.reserve(256);
+}
+
+Simulation::~Simulation() {
+    Stop();
+}
+
+void Simulation::Start(Directory* root) {
+    if (running) {
+        return;
+    }
+    terminal.Reset(root);
+    terminal.SetVisibleLines(viewRows);
+    Publish();
+
+    running = true;
+    thread = std::thread(&Simulation::ThreadLoop, this);
+}
+
+void Simulation::Stop() {
+    if (!running) {
+        return;
+    }
+    running = false;
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+void Simulation::Send(const Command& command) {
+    if (!commands.Push(command)) {
+        TraceLog(LOG_WARNING, "SIM: Command queue full, input dropped");
+    }
+}
+
+void Simulation::SendInput(const InputEvent& event) {
+    Command command;
+    command.type = event.type == InputEvent::CHAR ? CommandType::CHAR : CommandType::KEY;
+    command.value = event.code;
+    command.ctrl = event.ctrl;
+    command.time = event.time;
+    Send(command);
+}
+
+void Simulation::SendClick(Vector2 point) {
+    Command command;
+    command.type = CommandType::CLICK;
+    command.point = point;
+    Send(command);
+}
+
+void Simulation::SetViewRows(int rows) {
+    Command command;
+    command.type = CommandType::VIEW_ROWS;
+    command.value = rows;
+    Send(command);
+}
+
+void Simulation::ClearInput() {
+    Command command;
+    command.type = CommandType::CLEAR_INPUT;
+    Send(command);
+}
+
+void Simulation::StartBreach() {
+    Command command;
+    command.type = CommandType::START_BREACH;
+    Send(command);
+}
+
+void Simulation::RequestReset() {
+    Command command;
+    command.type = CommandType::RESET;
+    Send(command);
+}
+
+void Simulation::ThreadLoop() {
+    using Clock = std::chrono::steady_clock;
+    const auto stepDuration = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(STEP));
+
+    auto last = Clock::now();
+    float accumulator = 0.0f;
+    while (running) {
+        Command command;
+        while (commands.Pop(command)) {
+            command.step = stepCount;
+            pending.push_back(command);
+        }
+
+        // Steps are fixed; a stall is caught up on only as far as
+        // MAX_BACKLOG so it does not turn into a burst of steps
+        auto now = Clock::now();
+        accumulator += std::min(std::chrono::duration<float>(now - last).count(), MAX_BACKLOG);
+        last = now;
+        while (accumulator >= STEP) {
+            ApplyPending();
+            Step(STEP);
+            stepCount++;
+            accumulator -= STEP;
+        }
+
+        CollectRequests();
+        Publish();
+        FrameArena::Instance().Reset();
+
+        std::this_thread::sleep_until(now + stepDuration);
+    }
+}
+
+static const char* CommandName(int type) {
+    static const char* const names[] = {
+        "CHAR", "KEY", "CLICK", "VIEW_ROWS", "CLEAR_INPUT", "START_BREACH", "RESET"
+    };
+    return names[type];
+}
+
+void Simulation::ApplyPending() {
+    size_t kept = 0;
+    for (const Command& command : pending) {
+        if (command.step > stepCount) {
+            pending[kept++] = command;
+            continue;
+        }
+        // The replay log: what was applied, and before which step
+        TraceLog(LOG_DEBUG, "SIM: step %llu: %s %d%s (%.0f, %.0f)", (unsigned long long)stepCount,
+                 CommandName((int)command.type), command.value, command.ctrl ? " ctrl" : "",
+                 command.point.x, command.point.y);
+        Apply(command);
+    }
+    pending.resize(kept);
+}
+
+void Simulation::Apply(const Command& command) {
+    switch (command.type) {
+        case CommandType::CHAR:
+            terminal.HandleInput(command.value);
+            latency.Record(command.time);
+            break;
+        case CommandType::KEY:
+            terminal.HandleKey(command.value, command.ctrl);
+            latency.Record(command.time);
+            break;
+        case CommandType::CLICK:
+            if (breach) {
+                breach->click(command.point);
+                if (breach->isComplete()) {
+                    FinishBreach();
+                }
+            }
+            break;
+        case CommandType::VIEW_ROWS:
+            viewRows = std::max(1, command.value);
+            terminal.SetVisibleLines(viewRows);
+            break;
+        case CommandType::CLEAR_INPUT:
+            terminal.ClearInput();
+            break;
+        case CommandType::START_BREACH:
+            if (breach) {
+                breach->reset();
+            } else {
+                breach.emplace(screenWidth, screenHeight);
+            }
+            break;
+        case CommandType::RESET:
+            Reset();
+            break;
+    }
+}
+
+void Simulation::Step(float step) {
+    terminal.Tick(step);
+
+    // The countdown runs only while the minigame is up
+    if (breach) {
+        breach->update(step);
+        if (breach->isComplete()) {
+            FinishBreach();
+        }
+    }
+}
+
+void Simulation::FinishBreach() {
+    if (breach->isSuccessful()) {
+        Directory* secureDir = terminal.getCurrentDir()->FindFile(".secure");
+        if (secureDir) {
+            secureDir->setLocked(false);
+            terminal.addOutput("Access granted to .secure directory");
+            terminal.ProcessCommand("cd .secure");
+        }
+    } else {
+        breachAttempts--;
+        if (breachAttempts <= 0) {
+            terminal.addOutput("CRITICAL SECURITY BREACH DETECTED");
+            terminal.addOutput("YOU HAVE BEEN FOUND!");
+            terminal.lockSystem();
+        }
+    }
+    breach.reset();
+    breachResults++;
+}
+
+void Simulation::CollectRequests() {
+    // Terminal flags become counts the main thread can compare against
+    if (terminal.shouldInitiateBreachProtocol()) {
+        terminal.clearBreachProtocolFlag();
+        if (breachAttempts > 0) {
+            breachRequests++;
+        }
+    }
+    if (terminal.shouldRestartGame()) {
+        terminal.clearRestartFlag();
+        restartRequests++;
+    }
+}
+
+void Simulation::Reset() {
+    terminal.Reset(Directory::CreateFileSystem());
+    terminal.SetVisibleLines(viewRows);
+    breach.reset();
+    breachAttempts = MAX_BREACH_ATTEMPTS;
+    Directory::setClue1(false);
+    Directory::setClue2(false);
+    Directory::setClue3(false);
+    Directory::setNukeCodes(false);
+}
+
+static std::string_view ClipLine(std::string_view line, size_t maxBytes) {
+    return line.size() > maxBytes ? line.substr(0, maxBytes) : line;
+}
+
+void Simulation::Publish() {
+    // The back slot is two publishes old; its strings are reused in place
+    SimulationSnapshot& view = snapshots.Back();
+
+    view.pagerActive = terminal.isPagerActive();
+    if (view.pagerActive) {
+        CapturePager(view);
+    } else {
+        CaptureScrollback(view);
+    }
+
+    view.pendingWork = terminal.hasPendingWork();
+    view.locked = terminal.isSystemLocked();
+
+    const PopupDialog* messageDialog = terminal.GetMessageDialog();
+    const PopupDialog* storyDialog = terminal.GetStoryDialog();
+    view.messageVisible = messageDialog && messageDialog->IsVisible();
+    view.storyVisible = storyDialog && storyDialog->IsVisible();
+    if (view.messageVisible && view.messageDialog.GetVersion() != messageDialog->GetVersion()) {
+        view.messageDialog = *messageDialog;
+    }
+    if (view.storyVisible && view.storyDialog.GetVersion() != storyDialog->GetVersion()) {
+        view.storyDialog = *storyDialog;
+    }
+
+    if (!breach) {
+        view.breach.reset();
+    } else if (!view.breach || view.breach->getVersion() != breach->getVersion()) {
+        view.breach = breach;
+    }
+    view.breachTimeLeft = breach ? breach->getTimeLeft() : 0.0f;
+    view.breachAttempts = breachAttempts;
+    view.breachRequests = breachRequests;
+    view.breachResults = breachResults;
+    view.restartRequests = restartRequests;
+
+    snapshots.Publish();
+}
+
+void Simulation::CaptureScrollback(SimulationSnapshot& view) {
+    const Scrollback& output = terminal.GetOutput();
+    int totalLines = output.size();
+
+    // Offset clamped so the view never runs past the oldest line
+    int scrollOffset = std::min(terminal.GetScrollOffset(), std::max(0, totalLines - viewRows));
+    view.scrollOffset = scrollOffset;
+    view.canScrollUp = scrollOffset < totalLines - viewRows;
+
+    int startLine = std::max(0, totalLines - viewRows - scrollOffset);
+    int endLine = std::min(totalLines, startLine + viewRows);
+
+    const ScrollbackSearch& search = terminal.GetScrollbackSearch();
+    bool marking = search.IsActive() && !search.GetQuery().empty();
+    view.searchQuery = marking ? search.GetQuery() : std::string();
+
+    size_t count = endLine - startLine;
+    view.lines.resize(count);
+    view.marks.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        size_t line = startLine + i;
+        view.lines[i].assign(ClipLine(output[line], MAX_LINE_BYTES));
+        if (!marking || !search.IsMatchLine(line)) {
+            view.marks[i] = SimulationSnapshot::MARK_NONE;
+        } else if (static_cast<long>(line) == search.CurrentLine()) {
+            view.marks[i] = SimulationSnapshot::MARK_CURRENT;
+        } else {
+            view.marks[i] = SimulationSnapshot::MARK_MATCH;
+        }
+    }
+
+    FrameString inputLine;
+    terminal.GetInputLine(inputLine);
+    view.inputLine.assign(inputLine.View());
+}
+
+void Simulation::CapturePager(SimulationSnapshot& view) {
+    // Last row is the status bar; only the visible page is copied
+    Pager& pager = terminal.GetPager();
+    pager.SetPageLines(viewRows - 1);
+
+    size_t topLine = pager.GetTopLine();
+    int visibleCount = pager.VisibleLineCount();
+    view.pagerLines.resize(visibleCount);
+    for (int i = 0; i < visibleCount; i++) {
+        view.pagerLines[i].assign(ClipLine(pager.GetLine(topLine + i), MAX_LINE_BYTES));
+    }
+    FrameString status;
+    pager.GetStatusLine(status);
+    view.pagerStatus.assign(status.View());
+}
@@ -0,0 +1,153 @@
+#pragma once
+#include <raylib.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BreachProtocol.h"
+#include "Directory.h"
+#include "InputQueue.h"
+#include "LockFreeQueue.h"
+#include "PopupDialog.h"
+#include "Terminal.h"
+#include "TripleBuffer.h"
+
+// What the main thread draws the terminal and the breach minigame from.
+// Filled in by the simulation thread and read-only once published.
+struct SimulationSnapshot {
+    enum LineMark : uint8_t {
+        MARK_NONE,
+        MARK_MATCH,      // Holds a scrollback search match
+        MARK_CURRENT     // Holds the current match
+    };
+
+    // Scrollback in view, oldest first, clipped for the grid
+    std::vector<std::string> lines;
+    std::vector<uint8_t> marks;      // One per line
+    std::string searchQuery;         // Highlighted on marked lines
+    std::string inputLine;           // Prompt and input; shown at the bottom only
+    int scrollOffset = 0;
+    bool canScrollUp = false;
+
+    // `less` page and status bar, when the pager is up
+    bool pagerActive = false;
+    std::vector<std::string> pagerLines;
+    std::string pagerStatus;
+
+    bool pendingWork = false;        // Jobs running or a search scanning
+    bool locked = false;
+
+    // Dialogs and the board are copied only while visible and only when
+    // their version moved since this slot last held them
+    bool messageVisible = false;
+    bool storyVisible = false;
+    PopupDialog messageDialog;
+    PopupDialog storyDialog;
+
+    std::optional<BreachProtocol> breach;   // While a breach is running
+    float breachTimeLeft = 0.0f;             // Countdown, published every step
+    int breachAttempts = 0;
+
+    // Event counts; the main thread acts when one moves
+    unsigned breachRequests = 0;     // Terminal asked for the minigame
+    unsigned breachResults = 0;      // A breach ended, won or lost
+    unsigned restartRequests = 0;    // Player chose to restart
+};
+
+// Runs the terminal, its filesystem and the breach minigame on their own
+// thread.
+//
+// Everything that changes game state happens here at a fixed step, so a
+// slow command or job drain never holds up a frame. The main thread keeps
+// raylib's input and drawing: it forwards key presses and clicks as
+// commands through a lock-free ring and draws from the newest snapshot
+// taken from a triple buffer, without waiting on this thread.
+//
+// Commands take effect only at step boundaries. Each is stamped with the
+// index of the step it runs before and logged at LOG_DEBUG with it, so a
+// session's input can be replayed step for step.
+class Simulation {
+private:
+    enum class CommandType {
+        CHAR,
+        KEY,
+        CLICK,
+        VIEW_ROWS,
+        CLEAR_INPUT,
+        START_BREACH,
+        RESET
+    };
+
+    struct Command {
+        CommandType type = CommandType::CHAR;
+        int value = 0;           // Character, key code or row count
+        bool ctrl = false;
+        Vector2 point = {0, 0};
+        std::chrono::steady_clock::time_point time;   // Input collected, for CHAR/KEY
+        uint64_t step = 0;       // Applied before this step; set on arrival
+    };
+
+    static constexpr float STEP = 1.0f / 120.0f;
+    static constexpr float MAX_BACKLOG = 0.25f;   // Longest stall caught up on
+    static const int MAX_BREACH_ATTEMPTS = 3;
+    static const size_t MAX_LINE_BYTES = 4096;    // Past a few screens of wrapping
+
+    int screenWidth;
+    int screenHeight;
+
+    SpscRing<Command, 256> commands;
+    TripleBuffer<SimulationSnapshot> snapshots;
+    std::thread thread;
+    std::atomic<bool> running{false};
+
+    // Simulation thread only once started
+    Terminal terminal;
+    std::optional<BreachProtocol> breach;
+    int breachAttempts = MAX_BREACH_ATTEMPTS;
+    int viewRows = 17;
+    unsigned breachRequests = 0;
+    unsigned breachResults = 0;
+    unsigned restartRequests = 0;
+    InputLatency latency;
+    uint64_t stepCount = 0;          // Steps run so far
+    std::vector<Command> pending;    // Arrived, waiting for their step
+
+    void ThreadLoop();
+    void ApplyPending();
+    void Apply(const Command& command);
+    void Step(float step);
+    void FinishBreach();
+    void CollectRequests();
+    void Reset();
+    void Publish();
+    void CaptureScrollback(SimulationSnapshot& view);
+    void CapturePager(SimulationSnapshot& view);
+    void Send(const Command& command);
+
+public:
+    Simulation(int screenWidth, int screenHeight);
+    ~Simulation();
+    Simulation(const Simulation&) = delete;
+    Simulation& operator=(const Simulation&) = delete;
+
+    // Builds the terminal on `root`, which it then owns, and starts the thread
+    void Start(Directory* root);
+
+    // Joins the thread; call before anything the terminal uses goes away
+    void Stop();
+
+    // Main thread: newest snapshot, refreshed by Acquire() once per frame
+    void Acquire() { snapshots.Acquire(); }
+    const SimulationSnapshot& View() { return snapshots.Front(); }
+
+    // Main thread commands, applied before the next step to run
+    void SendInput(const InputEvent& event);
+    void SendClick(Vector2 point);
+    void SetViewRows(int rows);
+    void ClearInput();
+    void StartBreach();
+    void RequestReset();
+};
@@ -0,0 +1,119 @@
+#include "TaskGraph.h"
+#include <raylib.h>
+
+TaskGraph::~TaskGraph() {
+    for (std::thread& thread : threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+int TaskGraph::Add(const std::string& name, Thread thread, std::function<void()> work,
+                   std::vector<int> dependencies) {
+    if (started) {
+        TraceLog(LOG_WARNING, "Task '%s' added after the graph started", name.c_str());
+        return -1;
+    }
+    Task task;
+    task.name = name;
+    task.thread = thread;
+    task.work = std::move(work);
+    task.dependencies = std::move(dependencies);
+    tasks.push_back(std::move(task));
+    return (int)tasks.size() - 1;
+}
+
+bool TaskGraph::IsReady(const Task& task) const {
+    if (task.state != State::WAITING) {
+        return false;
+    }
+    for (int dependency : task.dependencies) {
+        if (!IsDone(dependency)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void TaskGraph::Run(int id) {
+    // The task list is not resized once started, so workers may write
+    // their own entry's timing
+    Clock::time_point begin = Clock::now();
+    tasks[id].work();
+    tasks[id].milliseconds = std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+}
+
+void TaskGraph::Start() {
+    if (started) {
+        return;
+    }
+    started = true;
+    startTime = Clock::now();
+    Launch(false);
+}
+
+void TaskGraph::Poll() {
+    if (!started || IsFinished()) {
+        return;
+    }
+
+    int id = 0;
+    while (finished.Pop(id)) {
+        tasks[id].state = State::DONE;
+        doneCount++;
+    }
+
+    Launch(true);
+
+    if (IsFinished()) {
+        Report();
+    }
+}
+
+void TaskGraph::Launch(bool runMainTasks) {
+    // Main-thread tasks can make others ready, so repeat until stable
+    bool progress = true;
+    while (progress) {
+        progress = false;
+        for (int i = 0; i < (int)tasks.size(); i++) {
+            Task& task = tasks[i];
+            if (!IsReady(task) || (task.thread == Thread::MAIN && !runMainTasks)) {
+                continue;
+            }
+            task.state = State::RUNNING;
+            if (task.thread == Thread::MAIN) {
+                Run(i);
+                task.state = State::DONE;
+                doneCount++;
+                progress = true;
+            } else {
+                threads.emplace_back([this, i] {
+                    Run(i);
+                    finished.Push(i);
+                });
+            }
+        }
+    }
+}
+
+void TaskGraph::Wait() {
+    while (started && !IsFinished()) {
+        Poll();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+void TaskGraph::Report() {
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    threads.clear();
+
+    double total = std::chrono::duration<double, std::milli>(Clock::now() - startTime).count();
+    TraceLog(LOG_INFO, "Startup tasks finished in %.1f ms", total);
+    for (const Task& task : tasks) {
+        TraceLog(LOG_INFO, "    %-12s %6.1f ms (%s)", task.name.c_str(), task.milliseconds,
+                 task.thread == Thread::MAIN ? "main" : "worker");
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include <chrono>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+#include "LockFreeQueue.h"
+
+// Small dependency graph for startup work.
+//
+// Each task runs either on its own worker thread or on the main thread
+// (for anything that needs the GL context), once all of its dependencies
+// have finished. Poll() drives the graph from the game loop, so the first
+// frames draw while tasks are still running; a timing summary is logged
+// when the last task completes.
+class TaskGraph {
+public:
+    enum class Thread {
+        MAIN,
+        WORKER
+    };
+
+private:
+    enum class State {
+        WAITING,
+        RUNNING,
+        DONE
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Task {
+        std::string name;
+        Thread thread;
+        std::function<void()> work;
+        std::vector<int> dependencies;
+        State state = State::WAITING;
+        double milliseconds = 0.0;    // Written by whichever thread ran it
+    };
+
+    std::vector<Task> tasks;
+    std::vector<std::thread> threads;
+    MpscQueue<int> finished;
+    Clock::time_point startTime;
+    int doneCount = 0;
+    bool started = false;
+
+    bool IsReady(const Task& task) const;
+    void Run(int id);
+    void Launch(bool runMainTasks);
+    void Report();
+
+public:
+    TaskGraph() = default;
+    ~TaskGraph();
+    TaskGraph(const TaskGraph&) = delete;
+    TaskGraph& operator=(const TaskGraph&) = delete;
+
+    // Tasks can only be added before Start(); returns the task's id
+    int Add(const std::string& name, Thread thread, std::function<void()> work,
+            std::vector<int> dependencies = {});
+
+    // Launches the worker tasks that have no pending dependencies;
+    // main-thread tasks wait for the first Poll()
+    void Start();
+
+    // Main thread: collects finished workers, runs ready main-thread tasks
+    // and launches newly ready workers
+    void Poll();
+
+    // Blocks until everything has run, e.g. before shutting down
+    void Wait();
+
+    bool IsDone(int id) const { return id >= 0 && id < (int)tasks.size() && tasks[id].state == State::DONE; }
+    bool IsFinished() const { return started && doneCount == (int)tasks.size(); }
+};
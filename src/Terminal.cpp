@@ -1,9 +1,8 @@
 #include "Terminal.h"
 #include <raylib.h>
+#include <algorithm>
 #include <sstream>
 #include <iomanip>
-#include <chrono>
-#include <thread>
 
 /*
 Terminal::Terminal(Directory* root)
@@ -18,36 +17,132 @@ Terminal::Terminal(Directory* root)
 */
 
 Terminal::Terminal(Directory* root)
-    : currentDir(root), rootDir(root), currentInput(""),
+    : currentDir(nullptr), rootDir(nullptr), currentInput(""),
       scrollOffset(0), maxScrollback(1000), currentScrollPosition(0),
-      linesPerPage(10), waitingForDecision(false) {
-    output.push_back("Terminal initialized. Type '--help' for commands.");
+      waitingForDecision(false) {
+    Reset(root);
+}
 
-    // Initialize dialog pointers with debug output
-    //output.push_back("DEBUG: Initializing message dialog");
-    messageDialog = new PopupDialog();
-    if (!messageDialog) {
-        output.push_back("ERROR: Failed to create message dialog");
-    }
+Terminal::~Terminal() {
+    // Jobs may still read the tree; the JobSystem cancels and joins them
+    jobs.reset();
+    FreeTrees();
+}
 
-    //output.push_back("DEBUG: Initializing story dialog");
-    storyDialog = new PopupDialog();
-    if (!storyDialog) {
-        output.push_back("ERROR: Failed to create story dialog");
-    }
+void Terminal::FreeTrees() {
+    delete remoteRoot;
+    remoteRoot = nullptr;
+    delete rootDir;
+    rootDir = nullptr;
+    currentDir = nullptr;
+    previousDir = nullptr;
+}
+
+void Terminal::Reset(Directory* root) {
+    jobs.reset();
+    foregroundJob = 0;
+    FreeTrees();
+    rootDir = root;
+    currentDir = root;
+
+    output.clear();
+    currentInput.clear();
+    scrollOffset = 0;
+    currentScrollPosition = 0;
+    pager = Pager();
+    scrollSearch = ScrollbackSearch();
+    lastJumpLine = -1;
+
+    historyCursor = -1;
+    savedInput.clear();
+    reverseSearch = false;
+    reverseSearchFailed = false;
+    searchQuery.clear();
+    searchMatch = -1;
+
+    m_isLocked = false;
+    m_initiateBreachProtocol = false;
+    m_isRemoteServer = false;
+    m_shouldRestart = false;
+
+    messageDialog = std::make_unique<PopupDialog>();
+    storyDialog = std::make_unique<PopupDialog>();
+    waitingForDecision = false;
 
+    output.push_back("Terminal initialized. Type '--help' for commands.");
     UpdatePrompt();
 }
 
-Terminal::~Terminal() {}
-
-void Terminal::ProcessScrollInput() {
-    if (IsKeyPressed(KEY_PAGE_UP) || IsKeyPressed(KEY_UP)) {
+void Terminal::HandleScrollKey(int key) {
+    if (pager.IsActive()) {
+        if (key == KEY_PAGE_UP) pager.PageUp();
+        if (key == KEY_PAGE_DOWN) pager.PageDown();
+        if (key == KEY_UP) pager.ScrollBy(-1);
+        if (key == KEY_DOWN) pager.ScrollBy(1);
+        if (key == KEY_HOME) pager.GoTop();
+        if (key == KEY_END) pager.GoBottom();
+        if (key == KEY_ESCAPE) pager.Cancel();
+        return;
+    }
+    if (scrollSearch.IsActive()) {
+        if (key == KEY_PAGE_UP) ScrollUp();
+        if (key == KEY_PAGE_DOWN) ScrollDown();
+        if (key == KEY_UP && scrollSearch.Previous()) JumpToSearchMatch();
+        if (key == KEY_DOWN && scrollSearch.Next()) JumpToSearchMatch();
+        if (key == KEY_ESCAPE) StopScrollbackSearch();
+        return;
+    }
+    if (key == KEY_PAGE_UP) {
         ScrollUp();
     }
-    if (IsKeyPressed(KEY_PAGE_DOWN) || IsKeyPressed(KEY_DOWN)) {
+    if (key == KEY_PAGE_DOWN) {
         ScrollDown();
     }
+    if (key == KEY_UP) {
+        HistoryUp();
+    }
+    if (key == KEY_DOWN) {
+        HistoryDown();
+    }
+}
+
+void Terminal::HandleKey(int key, bool ctrl) {
+    // CTRL+C interrupts the foreground job
+    if (ctrl && key == KEY_C) {
+        Interrupt();
+        return;
+    }
+
+    // CTRL+F searches the scrollback
+    if (ctrl && key == KEY_F && !pager.IsActive() && !reverseSearch) {
+        StartScrollbackSearch();
+        return;
+    }
+
+    // CTRL+R searches history, CTRL+G abandons the search
+    if (ctrl && key == KEY_R && !pager.IsActive() && !scrollSearch.IsActive()) {
+        StartReverseSearch();
+        return;
+    }
+    if (reverseSearch) {
+        if (ctrl && key == KEY_G) {
+            CancelReverseSearch();
+            return;
+        }
+        if (key == KEY_ESCAPE || key == KEY_LEFT || key == KEY_RIGHT) {
+            AcceptReverseSearch();
+        }
+    }
+
+    if (key == KEY_ENTER) {
+        SubmitInput();
+    }
+    if (key == KEY_BACKSPACE) {
+        BackspaceInput();
+    }
+
+    HandleScrollKey(key);
+    HandleDialogKey(key);
 }
 
 void Terminal::ScrollUp() {
@@ -62,20 +157,6 @@ void Terminal::ScrollDown() {
     }
 }
 
-void Terminal::displayContent() {
-    BeginDrawing();
-    ClearBackground(BLACK);
-
-    int visibleLines = std::min(linesPerPage, static_cast<int>(output.size()) - scrollOffset);
-    int yPos = 20;
-
-    for (int i = 0; i < visibleLines; ++i) {
-        DrawText(output[output.size() - 1 - scrollOffset - i].c_str(), 10, yPos, 20, GREEN);
-        yPos += 20;
-    }
-    EndDrawing();
-}
-
 /* old
 void Terminal::ExecuteCAT(const std::string& filename) {
     Directory* fileNode = currentDir->FindFile(filename);
@@ -99,6 +180,36 @@ void Terminal::ExecuteCAT(const std::string& filename) {
 }
 */
 
+// The launch codes on the remote server are never shown as a plain file;
+// whichever viewer opens them goes to the decision dialog instead
+bool Terminal::ShowLaunchCodes(const std::string& filename) {
+    if (filename != "codes.txt" || !m_isRemoteServer) {
+        return false;
+    }
+    output.push_back("DEBUG: Found codes.txt in remote server");
+    std::string choiceText =
+        "NUCLEAR LAUNCH CODES\n"
+        "===================\n"
+        "Authorization: ALPHA-ZULU-9\n"
+        "Confirmation: OMEGA-DELTA-4\n"
+        "Target Coordinates: [CLASSIFIED]\n"
+        "Launch Window: IMMEDIATE\n\n"
+        "What would you like to do?\n\n"
+        "1: Submit codes to Regime Command\n"
+        "2: Continue exploring the system";
+
+    if (Directory::hasFoundAllClues()) {
+        choiceText += "\n3: Send modified launch codes";
+    }
+    choiceText += "\n\nPress number key to choose";
+
+    output.push_back("DEBUG: Attempting to show message dialog");
+    messageDialog->Show(choiceText);
+    output.push_back("DEBUG: Message dialog shown");
+    waitingForDecision = true;
+    return true;
+}
+
 void Terminal::ExecuteCAT(const std::string& filename) {
     Directory* fileNode = currentDir->FindFile(filename);
     if (!fileNode) {
@@ -106,46 +217,33 @@ void Terminal::ExecuteCAT(const std::string& filename) {
         return;
     }
 
-    // Special handling for launch codes
-    if (filename == "codes.txt" && m_isRemoteServer) {
-        output.push_back("DEBUG: Found codes.txt in remote server");
-        if (!messageDialog) {
-            messageDialog = new PopupDialog();
-        }
-        std::string choiceText =
-            "NUCLEAR LAUNCH CODES\n"
-            "===================\n"
-            "Authorization: ALPHA-ZULU-9\n"
-            "Confirmation: OMEGA-DELTA-4\n"
-            "Target Coordinates: [CLASSIFIED]\n"
-            "Launch Window: IMMEDIATE\n\n"
-            "What would you like to do?\n\n"
-            "1: Submit codes to Regime Command\n"
-            "2: Continue exploring the system";
-
-        if (Directory::hasFoundAllClues()) {
-            choiceText += "\n3: Send modified launch codes";
-        }
-        choiceText += "\n\nPress number key to choose";
-
-        output.push_back("DEBUG: Attempting to show message dialog");
-        messageDialog->Show(choiceText);
-        output.push_back("DEBUG: Message dialog shown");
-        waitingForDecision = true;
+    if (ShowLaunchCodes(filename)) {
         return;
     }
 
-    // Regular file display
-    std::string content = fileNode->getVisibleContent();
-    std::istringstream stream(content);
-    std::string line;
+    // Regular file display: the output refers to the file's cached line
+    // index instead of copying each line
+    std::shared_ptr<LineIndex> lines = fileNode->getLineIndex();
 
     output.push_back("");
-    while (std::getline(stream, line)) {
-        output.push_back(line);
-    }
+    output.PushView(lines, 0, lines->LineCount());
     scrollOffset = 0;
-    displayContent();
+}
+
+void Terminal::ExecuteLess(const std::string& filename) {
+    Directory* fileNode = currentDir->FindFile(filename);
+    if (!fileNode) {
+        output.push_back("less: " + filename + ": No such file");
+        return;
+    }
+    if (fileNode->getIsDirectory()) {
+        output.push_back("less: " + filename + " is a directory");
+        return;
+    }
+    if (ShowLaunchCodes(filename)) {
+        return;
+    }
+    pager.Open(filename, fileNode->getLineIndex());
 }
 
 void Terminal::HandleInput(int key) {
@@ -154,12 +252,44 @@ void Terminal::HandleInput(int key) {
         m_shouldRestart = true;
     }
 
+    if (pager.IsActive()) {
+        pager.HandleChar(key);
+        return;
+    }
+
     if (key >= 32 && key <= 126) {  // Printable ASCII characters
+        if (scrollSearch.IsActive()) {
+            scrollSearch.AppendChar(static_cast<char>(key), output);
+            JumpToSearchMatch();
+            return;
+        }
+        if (reverseSearch) {
+            searchQuery += static_cast<char>(key);
+            // A longer query can still match the current entry
+            RunReverseSearch(searchMatch >= 0 ? searchMatch + 1 : static_cast<int>(CommandHistory::Instance().Size()));
+            return;
+        }
         currentInput += static_cast<char>(key);
     }
 }
 
 void Terminal::BackspaceInput() {
+    if (pager.IsActive()) {
+        pager.Backspace();
+        return;
+    }
+    if (scrollSearch.IsActive()) {
+        scrollSearch.Backspace();
+        JumpToSearchMatch();
+        return;
+    }
+    if (reverseSearch) {
+        if (!searchQuery.empty()) {
+            searchQuery.pop_back();
+            RunReverseSearch(static_cast<int>(CommandHistory::Instance().Size()));
+        }
+        return;
+    }
     if (!currentInput.empty()) {
         currentInput.pop_back();
     }
@@ -167,6 +297,163 @@ void Terminal::BackspaceInput() {
 
 void Terminal::ClearInput() {
     currentInput.clear();
+    historyCursor = -1;
+}
+
+void Terminal::SubmitInput() {
+    if (pager.IsActive()) {
+        pager.Submit();
+        return;
+    }
+    if (scrollSearch.IsActive()) {
+        // Leave the view where the search put it
+        StopScrollbackSearch();
+        return;
+    }
+    if (reverseSearch) {
+        AcceptReverseSearch();
+    }
+    // A foreground job owns the terminal; the line is kept for afterwards
+    if (foregroundJob != 0) {
+        if (!currentInput.empty()) {
+            output.push_back("[" + std::to_string(foregroundJob) + "] still running - press CTRL+C to interrupt");
+        }
+        return;
+    }
+    CommandHistory::Instance().Add(currentInput);
+    ProcessCommand(currentInput);
+    ClearInput();
+}
+
+void Terminal::HistoryUp() {
+    if (reverseSearch) {
+        AcceptReverseSearch();
+    }
+    const CommandHistory& history = CommandHistory::Instance();
+    if (history.Size() == 0) {
+        return;
+    }
+    if (historyCursor < 0) {
+        savedInput = currentInput;
+        historyCursor = static_cast<int>(history.Size()) - 1;
+    } else if (historyCursor > 0) {
+        historyCursor--;
+    }
+    currentInput = history.Get(historyCursor);
+}
+
+void Terminal::HistoryDown() {
+    if (reverseSearch) {
+        AcceptReverseSearch();
+    }
+    if (historyCursor < 0) {
+        return;
+    }
+    const CommandHistory& history = CommandHistory::Instance();
+    historyCursor++;
+    if (historyCursor >= static_cast<int>(history.Size())) {
+        historyCursor = -1;
+        currentInput = savedInput;
+    } else {
+        currentInput = history.Get(historyCursor);
+    }
+}
+
+void Terminal::StartReverseSearch() {
+    if (!reverseSearch) {
+        reverseSearch = true;
+        reverseSearchFailed = false;
+        savedInput = currentInput;
+        searchQuery.clear();
+        searchMatch = -1;
+        return;
+    }
+    // CTRL+R again: next older match for the same query
+    if (searchMatch > 0) {
+        RunReverseSearch(searchMatch);
+    }
+}
+
+void Terminal::RunReverseSearch(int before) {
+    if (searchQuery.empty()) {
+        searchMatch = -1;
+        reverseSearchFailed = false;
+        return;
+    }
+    int match = CommandHistory::Instance().SearchBackward(searchQuery, before);
+    reverseSearchFailed = (match < 0);
+    if (match >= 0) {
+        searchMatch = match;
+    }
+}
+
+void Terminal::AcceptReverseSearch() {
+    if (searchMatch >= 0) {
+        currentInput = CommandHistory::Instance().Get(searchMatch);
+        historyCursor = searchMatch;
+    }
+    reverseSearch = false;
+}
+
+void Terminal::CancelReverseSearch() {
+    currentInput = savedInput;
+    reverseSearch = false;
+}
+
+void Terminal::StartScrollbackSearch() {
+    if (!scrollSearch.IsActive()) {
+        scrollSearch.Start();
+        lastJumpLine = -1;
+        return;
+    }
+    // CTRL+F again: next older match
+    if (scrollSearch.Previous()) {
+        JumpToSearchMatch();
+    }
+}
+
+void Terminal::StopScrollbackSearch() {
+    scrollSearch.Stop();
+    lastJumpLine = -1;
+}
+
+void Terminal::JumpToSearchMatch() {
+    long line = scrollSearch.CurrentLine();
+    lastJumpLine = line;
+    if (line < 0) {
+        return;
+    }
+    // Put the match in the middle of the window
+    int total = static_cast<int>(output.size());
+    scrollOffset = std::max(0, total - visibleLines - static_cast<int>(line) + visibleLines / 2);
+}
+
+void Terminal::GetInputLine(FrameString& line) const {
+    if (scrollSearch.IsActive()) {
+        line.Append("(search)`").Append(scrollSearch.GetQuery()).Append("': ");
+        if (scrollSearch.MatchCount() > 0) {
+            line.AppendInt(scrollSearch.CurrentIndex() + 1).Append('/').AppendInt(scrollSearch.MatchCount());
+        } else if (!scrollSearch.GetQuery().empty() && !scrollSearch.IsScanning(output)) {
+            line.Append("no matches");
+        }
+        if (scrollSearch.IsScanning(output)) {
+            line.Append(" (searching...)");
+        }
+        return;
+    }
+    if (reverseSearch) {
+        line.Append(reverseSearchFailed ? "(failed reverse-i-search)`" : "(reverse-i-search)`");
+        line.Append(searchQuery).Append("': ");
+        if (searchMatch >= 0) {
+            line.Append(CommandHistory::Instance().Get(searchMatch));
+        }
+        return;
+    }
+    // While a foreground job runs there is no prompt, just the pending input
+    if (foregroundJob == 0) {
+        line.Append(prompt);
+    }
+    line.Append(currentInput);
 }
 
 void Terminal::ExecuteLS(const std::string& args) {
@@ -241,7 +528,7 @@ void Terminal::ExecutePWD() {
     output.push_back(path.empty() ? "/" : path);
 }
 
-void Terminal::ExecuteXXD(const std::string& filename) {
+void Terminal::ExecuteXXD(const std::string& filename, bool background) {
     Directory* fileNode = currentDir->FindFile(filename);
     if (!fileNode) {
         output.push_back("xxd: " + filename + ": No such file");
@@ -249,44 +536,46 @@ void Terminal::ExecuteXXD(const std::string& filename) {
     }
 
     std::string content = fileNode->getFullContent();
-    std::stringstream hexDump;
-    hexDump << std::hex << std::setfill('0');
+    StartJob("xxd " + filename, [content](JobContext& job) {
+        std::stringstream hexDump;
+        hexDump << std::hex << std::setfill('0');
 
-    const int maxBytes = 512;  // Limit to the first 128 bytes
-    const int bytesPerLine = 14;  // Display 8 bytes per line for balanced view
+        const int maxBytes = 512;  // Limit to the first 128 bytes
+        const int bytesPerLine = 14;  // Display 8 bytes per line for balanced view
 
-    // Limit content to `maxBytes`
-    int length = std::min(static_cast<int>(content.length()), maxBytes);
+        // Limit content to `maxBytes`
+        int length = std::min(static_cast<int>(content.length()), maxBytes);
 
-    for (int i = 0; i < length; i += bytesPerLine) {
-        // Address with a wider field
-        hexDump << std::setw(6) << i << ": ";
+        for (int i = 0; i < length && !job.IsCancelled(); i += bytesPerLine) {
+            // Address with a wider field
+            hexDump << std::setw(6) << i << ": ";
 
-        // Hex values with extra spacing between bytes
-        for (int j = 0; j < bytesPerLine; j++) {
-            if (i + j < length) {
-                hexDump << std::setw(1) << static_cast<int>(static_cast<unsigned char>(content[i + j])) << " ";
-            } else {
-                hexDump << "|";  // Padding for alignment if line is short
+            // Hex values with extra spacing between bytes
+            for (int j = 0; j < bytesPerLine; j++) {
+                if (i + j < length) {
+                    hexDump << std::setw(1) << static_cast<int>(static_cast<unsigned char>(content[i + j])) << " ";
+                } else {
+                    hexDump << "|";  // Padding for alignment if line is short
+                }
             }
-        }
 
-        // ASCII representation with extra space between hex and ASCII sections
-        hexDump << "|";
-        for (int j = 0; j < bytesPerLine && i + j < length; j++) {
-            char c = content[i + j];
-            hexDump << (isprint(c) ? c : '.');
-        }
-        hexDump << "|";
+            // ASCII representation with extra space between hex and ASCII sections
+            hexDump << "|";
+            for (int j = 0; j < bytesPerLine && i + j < length; j++) {
+                char c = content[i + j];
+                hexDump << (isprint(c) ? c : '.');
+            }
+            hexDump << "|";
 
-        output.push_back(hexDump.str());
-        hexDump.str("");  // Clear the stringstream
-        hexDump.clear();  // Reset any error flags
-    }
+            job.Print(hexDump.str());
+            hexDump.str("");  // Clear the stringstream
+            hexDump.clear();  // Reset any error flags
+        }
 
-    if (length < content.length()) {
-        output.push_back("... [truncated] ...");  // Indicate truncation if content is larger
-    }
+        if (length < content.length()) {
+            job.Print("... [truncated] ...");  // Indicate truncation if content is larger
+        }
+    }, background);
 }
 
 void Terminal::ExecuteHelp() {
@@ -295,14 +584,132 @@ void Terminal::ExecuteHelp() {
     output.push_back("  cd <dir>       : Change directory");
     output.push_back("  pwd            : Print working directory");
     output.push_back("  cat <file>     : Display file contents");
+    output.push_back("  less <file>    : Page through a file");
     output.push_back("  xxd <file>     : Display file contents in hex");
     //output.push_back("  analyze <file> : Analyze network configuration");
     output.push_back("  breach <dir>   : Initiate ICE breach protocol");
     output.push_back("  ssh <user@ip> -p <port> : Connect to remote server");
+    output.push_back("  jobs           : List background jobs");
+    output.push_back("  fg %<n>        : Bring a job to the foreground");
+    output.push_back("  kill %<n>      : Cancel a job");
+    output.push_back("  <cmd> &        : Run a command in the background");
+    output.push_back("  CTRL+C         : Interrupt the foreground job");
     output.push_back("  clear          : Clear the terminal");
     output.push_back("  help           : Display this help message");
 }
 
+void Terminal::ExecuteJobs() {
+    if (!jobs || jobs->GetJobs().empty()) {
+        return;
+    }
+    for (const auto& entry : jobs->GetJobs()) {
+        const Job& job = *entry.second;
+        // The worker owns the state; a cancelled job keeps it until the
+        // worker next checks in
+        JobState jobState = job.state.load();
+        std::string state;
+        switch (jobState) {
+            case JobState::QUEUED:    state = job.cancelRequested ? "Stopping" : "Queued";  break;
+            case JobState::RUNNING:   state = job.cancelRequested ? "Stopping" : "Running"; break;
+            case JobState::DONE:      state = "Done";    break;
+            case JobState::CANCELLED: state = "Stopped"; break;
+        }
+        output.push_back("[" + std::to_string(job.id) + "]  " + state + "    " + job.command +
+                         (job.background ? " &" : ""));
+    }
+}
+
+void Terminal::ExecuteFG(const std::string& args) {
+    int jobId = ParseJobId(args);
+    std::shared_ptr<Job> job = jobs ? jobs->Find(jobId) : nullptr;
+    if (!job) {
+        output.push_back("fg: " + (args.empty() ? std::string("current") : args) + ": no such job");
+        return;
+    }
+    job->background = false;
+    foregroundJob = job->id;
+    output.push_back(job->command);
+}
+
+void Terminal::ExecuteKill(const std::string& args) {
+    int jobId = ParseJobId(args);
+    if (!jobs || !jobs->Cancel(jobId)) {
+        output.push_back("kill: " + args + ": no such job");
+    }
+}
+
+int Terminal::ParseJobId(const std::string& args) const {
+    if (args.empty()) {
+        // Default to the most recent job, like a shell's "current job"
+        return (jobs && !jobs->GetJobs().empty()) ? jobs->GetJobs().rbegin()->first : 0;
+    }
+    std::string spec = args[0] == '%' ? args.substr(1) : args;
+    try {
+        return std::stoi(spec);
+    } catch (const std::exception&) {
+        return 0;
+    }
+}
+
+int Terminal::StartJob(const std::string& command, std::function<void(JobContext&)> work, bool background) {
+    if (!jobs) {
+        jobs = std::make_shared<JobSystem>();
+    }
+    int jobId = jobs->Submit(command, std::move(work), background);
+    if (background) {
+        output.push_back("[" + std::to_string(jobId) + "] " + command);
+    } else {
+        foregroundJob = jobId;
+    }
+    return jobId;
+}
+
+void Terminal::DrainJobEvents() {
+    if (!jobs) {
+        return;
+    }
+
+    JobEvent event;
+    while (jobs->PopEvent(event)) {
+        if (event.callback) {
+            event.callback();
+        } else if (!event.finished) {
+            output.push_back(event.line);
+        }
+
+        if (event.finished) {
+            std::shared_ptr<Job> job = jobs->Find(event.jobId);
+            if (job && job->background) {
+                std::string status = job->state == JobState::CANCELLED ? "Terminated" : "Done";
+                output.push_back("[" + std::to_string(job->id) + "]+ " + status + "    " + job->command);
+            }
+            if (event.jobId == foregroundJob) {
+                foregroundJob = 0;
+            }
+            jobs->Forget(event.jobId);
+        }
+    }
+}
+
+void Terminal::Interrupt() {
+    if (pager.IsActive()) {
+        pager.Cancel();
+        return;
+    }
+    if (scrollSearch.IsActive()) {
+        StopScrollbackSearch();
+        return;
+    }
+    if (foregroundJob != 0 && jobs) {
+        jobs->Cancel(foregroundJob);
+        output.push_back("^C");
+        return;
+    }
+    // No job running: behave like a shell and drop the current line
+    output.push_back(prompt + currentInput + "^C");
+    currentInput.clear();
+}
+
 int Terminal::CountFiles(Directory* dir, bool includeHidden) const {
     int count = 0;
     Directory* node = dir->getLeftChild();
@@ -400,6 +807,7 @@ void Terminal::ProcessCommand(const std::string& command) {
     }
     else if (cmd == "clear") {
         output.clear();
+        scrollSearch.Invalidate();
     }
     else if (cmd == "analyze") {
         ProcessAnalyzeCommand(args);
@@ -461,15 +869,28 @@ void Terminal::ProcessCommand(const std::string& command) {
         output.push_back("ERROR: System locked - Security breach detected");
         return;
     }
+    // Input waits while a foreground job owns the terminal
+    if (foregroundJob != 0) {
+        return;
+    }
     // Add command to output history
     output.push_back(prompt + command);
+    // A trailing '&' sends job-capable commands to the background
+    std::string line = command;
+    bool background = false;
+    size_t last = line.find_last_not_of(' ');
+    if (last != std::string::npos && line[last] == '&') {
+        background = true;
+        line = line.substr(0, last);
+    }
     // Parse command and arguments
-    std::istringstream iss(command);
+    std::istringstream iss(line);
     std::string cmd;
     iss >> cmd;
     std::string args;
     std::getline(iss, args);
     if (!args.empty()) args = args.substr(1);
+    while (!args.empty() && args.back() == ' ') args.pop_back();
     // Process commands
     if (cmd == "help" || cmd == "--help") {
         ExecuteHelp();
@@ -484,43 +905,34 @@ void Terminal::ProcessCommand(const std::string& command) {
         ExecutePWD();
     }
     else if (cmd == "cat") {
-        // Check for clue files
-        if (args == "regime_activities.txt") {
-            ExecuteCAT(args);
-            if (currentDir->FindFile(args)) {
-                Directory::setClue1(true);
-                Directory::setPlayerThought("...These are our humanitarian missions?", 5.0f);
-            }
-        }
-        else if (args == "intercepted_comms.log") {
-            ExecuteCAT(args);
-            if (currentDir->FindFile(args)) {
-                Directory::setClue2(true);
-                Directory::setPlayerThought("...We're using aid centers for targeting?", 5.0f);
-            }
-        }
-        else if (args == "operation_truth.enc") {
-            ExecuteCAT(args);
-            if (currentDir->FindFile(args)) {
-                Directory::setClue3(true);
-                Directory::setPlayerThought("...50 million civilians... This can't be right...", 5.0f);
-            }
-        }
-        else {
-            ExecuteCAT(args);
-        }
+        ExecuteCAT(args);
+        RevealClue(args);
+    }
+    else if (cmd == "less") {
+        ExecuteLess(args);
+        RevealClue(args);
     }
     else if (cmd == "xxd" || cmd == "hexdump") {
-        ExecuteXXD(args);
+        ExecuteXXD(args, background);
     }
     else if (cmd == "clear") {
         output.clear();
+        scrollSearch.Invalidate();
     }
     else if (cmd == "analyze") {
-        ProcessAnalyzeCommand(args);
+        ProcessAnalyzeCommand(args, background);
     }
     else if (cmd == "ssh") {
-        ProcessSSHCommand(command);
+        ProcessSSHCommand(line, background);
+    }
+    else if (cmd == "jobs") {
+        ExecuteJobs();
+    }
+    else if (cmd == "fg") {
+        ExecuteFG(args);
+    }
+    else if (cmd == "kill") {
+        ExecuteKill(args);
     }
     else if (cmd == "breach") {
         // First try to find it as a directory by searching through children
@@ -557,25 +969,49 @@ void Terminal::ProcessCommand(const std::string& command) {
     }
 }
 
-void Terminal::ProcessAnalyzeCommand(const std::string& filename) {
+void Terminal::RevealClue(const std::string& filename) {
+    // Check for clue files
+    if (!currentDir->FindFile(filename)) {
+        return;
+    }
+    if (filename == "regime_activities.txt") {
+        Directory::setClue1(true);
+        Directory::setPlayerThought("...These are our humanitarian missions?", 5.0f);
+    }
+    else if (filename == "intercepted_comms.log") {
+        Directory::setClue2(true);
+        Directory::setPlayerThought("...We're using aid centers for targeting?", 5.0f);
+    }
+    else if (filename == "operation_truth.enc") {
+        Directory::setClue3(true);
+        Directory::setPlayerThought("...50 million civilians... This can't be right...", 5.0f);
+    }
+}
+
+void Terminal::ProcessAnalyzeCommand(const std::string& filename, bool background) {
     Directory* file = currentDir->FindFile(filename);
     if (!file || !file->isConfigFile()) {
         output.push_back("Error: Cannot analyze this file type.");
     } else if (!file->hasRemainingAttempts()) {
         output.push_back("No analysis attempts remaining.");
     } else {
+        // Consume the attempt now; only the slow printout runs on the worker
         std::string analysis = file->analyzeFile();
-        std::istringstream iss(analysis);
-        std::string line;
-
-        while (std::getline(iss, line)) {
-            output.push_back(line);
-            std::this_thread::sleep_for(std::chrono::milliseconds(50)); // Optional delay
-        }
+        StartJob("analyze " + filename, [analysis](JobContext& job) {
+            std::istringstream iss(analysis);
+            std::string line;
+
+            while (std::getline(iss, line)) {
+                job.Print(line);
+                if (!job.Wait(0.05f)) { // Optional delay
+                    return;
+                }
+            }
+        }, background);
     }
 }
 
-void Terminal::ProcessSSHCommand(const std::string& command) {
+void Terminal::ProcessSSHCommand(const std::string& command, bool background) {
     std::istringstream iss(command);
     std::string cmd, connection, portFlag, port;
     iss >> cmd >> connection >> portFlag >> port;
@@ -594,47 +1030,93 @@ void Terminal::ProcessSSHCommand(const std::string& command) {
         return;
     }
 
-    output.push_back("Attempting connection to " + ip + "...");
-    std::this_thread::sleep_for(std::chrono::milliseconds(500));
-
-    if (user == "admin" && ip == "192.168.1.100" && port == "444") {
-        output.push_back("Establishing secure connection...");
-        std::this_thread::sleep_for(std::chrono::milliseconds(300));
-        output.push_back("Authenticating...");
-        std::this_thread::sleep_for(std::chrono::milliseconds(300));
-        output.push_back("Access granted. ALLIANCE_SECURE_SERVER");
-        output.push_back("----------------------------------");
-        output.push_back("WARNING: This is a restricted system.");
-        output.push_back("All activities are being monitored.");
-
-        // Create SHADOW_SERVER directory
-        Directory* shadowRoot = Directory::CreateDirectory("ALLIANCE_SECURE_SERVER", nullptr, false, true);
-        Directory* codesFile = shadowRoot->addFile("codes.txt",
-            "NUCLEAR LAUNCH CODES\n"
-            "===================\n"
-            "Authorization: ALPHA-ZULU-9\n"
-            "Confirmation: OMEGA-DELTA-4\n",
-            //"Target Coordinates: [CLASSIFIED]\n"
-            //"Launch Window: IMMEDIATE\n",
-            false);
-
-        // Store current directory and switch to SHADOW_SERVER
-        previousDir = currentDir;
-        currentDir = shadowRoot;
-        setRemoteServer(true);
-        UpdatePrompt();
-    } else {
-        output.push_back("Connection failed: Invalid credentials");
-        output.push_back("Warning: Access attempt has been logged");
+    bool validCredentials = (user == "admin" && ip == "192.168.1.100" && port == "444");
+
+    StartJob(command, [this, ip, validCredentials](JobContext& job) {
+        job.Print("Attempting connection to " + ip + "...");
+        if (!job.Wait(0.5f)) return;
+
+        if (!validCredentials) {
+            job.Print("Connection failed: Invalid credentials");
+            job.Print("Warning: Access attempt has been logged");
+            return;
+        }
+
+        job.Print("Establishing secure connection...");
+        if (!job.Wait(0.3f)) return;
+        job.Print("Authenticating...");
+        if (!job.Wait(0.3f)) return;
+        job.Print("Access granted. ALLIANCE_SECURE_SERVER");
+        job.Print("----------------------------------");
+        job.Print("WARNING: This is a restricted system.");
+        job.Print("All activities are being monitored.");
+
+        // Directory tree and prompt belong to the terminal thread
+        job.OnTerminalThread([this]() {
+            // Create SHADOW_SERVER directory
+            Directory* shadowRoot = Directory::CreateDirectory("ALLIANCE_SECURE_SERVER", nullptr, false, true);
+            Directory* codesFile = shadowRoot->addFile("codes.txt",
+                "NUCLEAR LAUNCH CODES\n"
+                "===================\n"
+                "Authorization: ALPHA-ZULU-9\n"
+                "Confirmation: OMEGA-DELTA-4\n",
+                //"Target Coordinates: [CLASSIFIED]\n"
+                //"Launch Window: IMMEDIATE\n",
+                false);
+
+            // Store current directory and switch to SHADOW_SERVER
+            if (!remoteRoot) {
+                previousDir = currentDir;
+            }
+            delete remoteRoot;
+            remoteRoot = shadowRoot;
+            currentDir = shadowRoot;
+            setRemoteServer(true);
+            UpdatePrompt();
+        });
+    }, background);
+}
+
+bool Terminal::hasPendingWork() const {
+    if (foregroundJob != 0 || scrollSearch.IsScanning(output)) {
+        return true;
     }
+    if (jobs) {
+        for (const auto& entry : jobs->GetJobs()) {
+            JobState state = entry.second->state.load(std::memory_order_relaxed);
+            if (state == JobState::QUEUED || state == JobState::RUNNING) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
 
+void Terminal::Tick(float step) {
+    DrainJobEvents();
 
+    // Pick up matches in newly appended lines; follow the first hit
+    scrollSearch.Update(output);
+    if (scrollSearch.IsActive() && lastJumpLine < 0 && scrollSearch.CurrentLine() >= 0) {
+        JumpToSearchMatch();
+    }
+
+    if (messageDialog) {
+        messageDialog->Tick(step);
+    }
+    if (storyDialog) {
+        storyDialog->Tick(step);
+    }
+    Directory::updateThoughtTimer(step);
 }
 
-void Terminal::Update() {
+void Terminal::HandleDialogKey(int key) {
     if (storyDialog && storyDialog->IsVisible()) {
         if (storyDialog && storyDialog->IsVisible()) {
-            if (IsKeyPressed(KEY_ESCAPE)) {
+            if (key == KEY_SPACE || key == KEY_ENTER) {
+                storyDialog->SkipTyping();
+            }
+            if (key == KEY_ESCAPE) {
                 storyDialog->Hide();
                 if (m_isLocked) {
                     m_shouldRestart = true;  // Set flag to restart game
@@ -646,14 +1128,10 @@ void Terminal::Update() {
     }
 
     if (waitingForDecision && messageDialog->IsVisible()) {
-        if (IsKeyPressed(KEY_ONE)) {
+        if (key == KEY_ONE) {
             messageDialog->Hide();
             waitingForDecision = false;
 
-            if (!storyDialog) {
-                storyDialog = new PopupDialog();
-            }
-
             std::string badEndingText =
                 "Submitting launch codes to Regime Command...\n\n"
                 "Authorization codes verified.\n"
@@ -664,18 +1142,18 @@ void Terminal::Update() {
                 "BAD ENDING: Unwitting Accomplice\n\n"
                 "Press ESC to restart";
 
-            storyDialog->Show(badEndingText);
+            storyDialog->Show(badEndingText, 60.0f);
             Directory::setNukeCodes(true);
             lockSystem();
         }
-        else if (IsKeyPressed(KEY_TWO)) {
+        else if (key == KEY_TWO) {
             messageDialog->Hide();
             waitingForDecision = false;
             setRemoteServer(false);
             output.push_back("\nReturning to local system...");
             output.push_back("You should look around for more information...");
         }
-        else if (IsKeyPressed(KEY_THREE) && Directory::hasFoundAllClues()) {
+        else if (key == KEY_THREE && Directory::hasFoundAllClues()) {
             messageDialog->Hide();
             waitingForDecision = false;
 
@@ -692,18 +1170,9 @@ void Terminal::Update() {
                 "The evidence you found gave you the courage to act.\n\n"
                 "Press ESC to restart";
 
-            storyDialog->Show(goodEndingText);
+            storyDialog->Show(goodEndingText, 60.0f);
             Directory::setNukeCodes(true);
             lockSystem();
         }
     }
 }
-
-void Terminal::Draw() {
-    if (messageDialog && messageDialog->IsVisible()) {
-        messageDialog->Draw();
-    }
-    if (storyDialog && storyDialog->IsVisible()) {
-        storyDialog->Draw();
-    }
-}
@@ -1,26 +1,43 @@
 #pragma once
+#include <functional>
+#include <memory>
 #include <string>
 #include <vector>
+#include "CommandHistory.h"
 #include "Directory.h"
+#include "FrameArena.h"
+#include "JobSystem.h"
+#include "Pager.h"
 #include "PopupDialog.h"
+#include "Scrollback.h"
+#include "ScrollbackSearch.h"
 
 class Terminal {
 private:
     Directory* currentDir;
     Directory* rootDir;
-    std::vector<std::string> output;
+    Scrollback output;
     std::string currentInput;
     std::string prompt;
     int scrollOffset;
     int maxScrollback;
 
     // Scroll handling variables
-    int linesPerPage = 10;
     int currentScrollPosition = 0;
-    std::vector<std::string> catContent;
+
+    // Full-screen `less` view; takes over input and drawing while active
+    Pager pager;
+
+    // CTRL+F search over the output
+    ScrollbackSearch scrollSearch;
+    int visibleLines = 17;
+    long lastJumpLine = -1;
+    void JumpToSearchMatch();
 
     // Private methods
     void UpdatePrompt();
+    void HandleScrollKey(int key);
+    void HandleDialogKey(int key);
     int CountFiles(Directory* dir, bool includeHidden) const;
 
     // Command execution methods
@@ -28,46 +45,100 @@ private:
     void ExecuteCD(const std::string& path);
     void ExecutePWD();
     void ExecuteCAT(const std::string& filename);
-    void ExecuteXXD(const std::string& filename);
+    void ExecuteLess(const std::string& filename);
+    bool ShowLaunchCodes(const std::string& filename);
+    void RevealClue(const std::string& filename);
+    void ExecuteXXD(const std::string& filename, bool background);
     void ExecuteHelp();
-    void ProcessAnalyzeCommand(const std::string& filename);
-    void ProcessSSHCommand(const std::string& command);
+    void ExecuteJobs();
+    void ExecuteFG(const std::string& args);
+    void ExecuteKill(const std::string& args);
+    void ProcessAnalyzeCommand(const std::string& filename, bool background);
+    void ProcessSSHCommand(const std::string& command, bool background);
+
+    // Job control: long commands run on the worker pool and report back
+    // through the job event queue, drained every simulation step in Tick()
+    std::shared_ptr<JobSystem> jobs;
+    int foregroundJob = 0;
+    int StartJob(const std::string& command, std::function<void(JobContext&)> work, bool background);
+    void DrainJobEvents();
+    int ParseJobId(const std::string& args) const;
+
+    // History recall (UP/DOWN) and CTRL+R reverse-incremental search
+    int historyCursor = -1;
+    std::string savedInput;
+    bool reverseSearch = false;
+    bool reverseSearchFailed = false;
+    std::string searchQuery;
+    int searchMatch = -1;
+    void RunReverseSearch(int before);
 
     // State flags
     bool m_isLocked = false;
     bool m_initiateBreachProtocol = false;
     bool m_isRemoteServer = false;
     Directory* previousDir = nullptr;
+    Directory* remoteRoot = nullptr;   // The ssh server's tree while connected
 
     // Dialog handling
-    PopupDialog* messageDialog;
-    PopupDialog* storyDialog;
+    std::unique_ptr<PopupDialog> messageDialog;
+    std::unique_ptr<PopupDialog> storyDialog;
     bool waitingForDecision;
 
+    void FreeTrees();
+
     // restart game
     bool m_shouldRestart = false;
 
 public:
+    // Takes ownership of the tree at `root`
     Terminal(Directory* root);
+    Terminal(const Terminal&) = delete;
+    Terminal& operator=(const Terminal&) = delete;
+
+    // Start over on a new tree: cancels jobs, frees the old tree and
+    // clears input, output, searches, dialogs and flags
+    void Reset(Directory* root);
+
     void HandleInput(int key);
     void ProcessCommand(const std::string& command);
+    void SubmitInput();
+    void Interrupt();
     void BackspaceInput();
     void ClearInput();
 
+    // History
+    void HistoryUp();
+    void HistoryDown();
+    void StartReverseSearch();
+    void AcceptReverseSearch();
+    void CancelReverseSearch();
+    bool isReverseSearching() const { return reverseSearch; }
+
+    // Scrollback search
+    void StartScrollbackSearch();
+    void StopScrollbackSearch();
+    bool isSearchingScrollback() const { return scrollSearch.IsActive(); }
+    const ScrollbackSearch& GetScrollbackSearch() const { return scrollSearch; }
+    void SetVisibleLines(int count) { visibleLines = count; }
+
     // Destructor
     ~Terminal();
 
     // Accessors
-    const std::vector<std::string>& GetOutput() const { return output; }
-    std::string GetInput() const { return currentInput; }
+    const Scrollback& GetOutput() const { return output; }
+    const std::string& GetInput() const { return currentInput; }
     const std::string& GetPrompt() const { return prompt; }
+    void GetInputLine(FrameString& line) const;   // Prompt, or search status, and input
     int GetScrollOffset() const { return scrollOffset; }
+    bool hasForegroundJob() const { return foregroundJob != 0; }
+    bool hasPendingWork() const;  // Jobs running or search still scanning
+    bool isPagerActive() const { return pager.IsActive(); }
+    Pager& GetPager() { return pager; }
 
     // Scroll control
     void ScrollUp();
     void ScrollDown();
-    void ProcessScrollInput();
-    void displayContent();
 
     // System state methods
     void lockSystem() { m_isLocked = true; }
@@ -78,13 +149,11 @@ public:
     void setRemoteServer(bool value) {
         m_isRemoteServer = value;
         if (!value && previousDir) {
-            // Clean up SHADOW_SERVER directory
-            if (currentDir && currentDir->getName() == "ALLIANCE_COMMAND_SECURE_SERVER") {
-                delete currentDir;
-            }
-            // Return to previous directory
+            // Return to previous directory and drop the server's tree
             currentDir = previousDir;
             previousDir = nullptr;
+            delete remoteRoot;
+            remoteRoot = nullptr;
             UpdatePrompt();
         }
     }
@@ -104,9 +173,16 @@ public:
 
     Directory* getCurrentDir() const { return currentDir; }
 
+    // A key press (raylib key code) other than text, which goes through
+    // HandleInput: editing, scrolling, searches, the pager and dialogs
+    void HandleKey(int key, bool ctrl);
+
+    // Job output, dialogs and timers, on simulated time
+    void Tick(float step);
+
     // Dialog handling
-    void Update();
-    void Draw();
+    const PopupDialog* GetMessageDialog() const { return messageDialog.get(); }
+    const PopupDialog* GetStoryDialog() const { return storyDialog.get(); }
     bool hasActiveDialog() const {
         return (messageDialog != nullptr && messageDialog->IsVisible()) ||
                (storyDialog != nullptr && storyDialog->IsVisible());
@@ -0,0 +1,79 @@
+#include "TerminalCompose.h"
+#include "Simulation.h"
+#include <algorithm>
+
+static void ComposeScrollback(TerminalGrid& grid, const SimulationSnapshot& view, int& cursorRow, int& cursorCol) {
+    // The simulation picked the lines in view and clipped them
+    const std::string& query = view.searchQuery;
+    for (size_t i = 0; i < view.lines.size(); i++) {
+        if (i > 0) {
+            grid.NewLine();
+        }
+        // Attributes do not carry across lines: the view can start anywhere
+        grid.ResetAttributes();
+
+        std::string_view line = view.lines[i];
+        if (view.marks[i] == SimulationSnapshot::MARK_NONE || query.empty()) {
+            grid.Feed(line);
+            continue;
+        }
+
+        // Feed the line in pieces so matches get the highlight background
+        uint8_t markAttr = (view.marks[i] == SimulationSnapshot::MARK_CURRENT) ? TerminalGrid::ATTR_MARK_CURRENT : TerminalGrid::ATTR_MARK;
+        size_t fed = 0;
+        size_t pos = line.find(query);
+        while (pos != std::string_view::npos) {
+            grid.Feed(line.substr(fed, pos - fed));
+            grid.SetMark(markAttr);
+            grid.Feed(line.substr(pos, query.size()));
+            grid.SetMark(0);
+            fed = pos + query.size();
+            pos = line.find(query, fed);
+        }
+        grid.Feed(line.substr(fed));
+    }
+
+    // Input line and cursor only when we're at the bottom
+    cursorRow = -1;
+    if (view.scrollOffset == 0) {
+        if (!view.lines.empty()) {
+            grid.NewLine();
+        }
+        grid.ResetAttributes();
+        grid.Feed(view.inputLine);
+        cursorRow = grid.GetCursorRow();
+        cursorCol = grid.GetCursorCol();
+    }
+}
+
+static void ComposePager(TerminalGrid& grid, const SimulationSnapshot& view, int& cursorRow) {
+    // Last row is the status bar; the simulation sized the page to fit
+    int rows = grid.GetRows();
+
+    // Long lines are clipped at the right edge like less -S
+    grid.SetAutowrap(false);
+    int visibleCount = std::min(static_cast<int>(view.pagerLines.size()), rows - 1);
+    for (int i = 0; i < visibleCount; i++) {
+        grid.MoveCursor(i, 0);
+        grid.ResetAttributes();
+        grid.Feed(view.pagerLines[i]);
+    }
+
+    grid.MoveCursor(rows - 1, 0);
+    grid.ResetAttributes();
+    grid.SetMark(TerminalGrid::ATTR_MARK);
+    grid.Feed(view.pagerStatus);
+    grid.EraseToEndOfLine();
+    grid.SetMark(0);
+    cursorRow = -1;
+}
+
+void ComposeTerminal(TerminalGrid& grid, const SimulationSnapshot& view, int& cursorRow, int& cursorCol) {
+    grid.BeginCompose();
+    if (view.pagerActive) {
+        ComposePager(grid, view, cursorRow);
+    } else {
+        ComposeScrollback(grid, view, cursorRow, cursorCol);
+    }
+    grid.EndCompose();
+}
@@ -0,0 +1,12 @@
+#pragma once
+#include "TerminalGrid.h"
+
+struct SimulationSnapshot;
+
+// Lays a terminal snapshot out in a configured cell grid: the scrollback
+// with search matches highlighted and the input line, or the `less` page
+// and its status bar. Runs every frame, so it only writes cells.
+//
+// cursorRow/cursorCol get the cell after the input line; cursorRow is -1
+// when the input line is scrolled out of view or the pager is up.
+void ComposeTerminal(TerminalGrid& grid, const SimulationSnapshot& view, int& cursorRow, int& cursorCol);
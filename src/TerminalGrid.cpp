@@ -0,0 +1,525 @@
+#include "TerminalGrid.h"
+#include "TextMetrics.h"
+#include <algorithm>
+
+TerminalGrid::TerminalGrid()
+    : cols(0),
+      rows(0),
+      cursorRow(0),
+      cursorCol(0),
+      savedRow(0),
+      savedCol(0),
+      wrapPending(false),
+      autowrap(true),
+      pen({' ', 0, 0, ATTR_DEFAULT_FG | ATTR_DEFAULT_BG, 0}),
+      mark(0),
+      state(ParseState::GROUND),
+      params(),
+      paramCount(0),
+      privateMode(false),
+      utf8Codepoint(0),
+      utf8Remaining(0),
+      fontSize(0),
+      cellWidth(0),
+      cellHeight(0),
+      glyphOffset(),
+      target({0}),
+      fullRedraw(true) {
+}
+
+void TerminalGrid::Configure(int newCols, int newRows, int newFontSize, int newCellWidth, int newCellHeight) {
+    newCols = std::max(1, newCols);
+    newRows = std::max(1, newRows);
+    if (newCols == cols && newRows == rows && newFontSize == fontSize &&
+        newCellWidth == cellWidth && newCellHeight == cellHeight) {
+        return;
+    }
+
+    cols = newCols;
+    rows = newRows;
+    fontSize = newFontSize;
+    cellWidth = newCellWidth;
+    cellHeight = newCellHeight;
+
+    cells.assign(cols * rows, BlankCell());
+    drawn.assign(cols * rows, Cell{0, 0, 0, 0, 0});
+    dirty.assign(rows, 1);
+    fullRedraw = true;
+    cursorRow = std::min(cursorRow, rows - 1);
+    cursorCol = std::min(cursorCol, cols - 1);
+
+    // The default font is proportional; center each glyph in its cell
+    TextMetrics& metrics = TextMetrics::Instance();
+    for (int c = 32; c <= 126; c++) {
+        char glyph = static_cast<char>(c);
+        int width = metrics.Measure(std::string_view(&glyph, 1), fontSize);
+        glyphOffset[c - 32] = static_cast<uint8_t>(std::max(0, (cellWidth - width) / 2));
+    }
+
+    // Texture size follows the geometry
+    Unload();
+}
+
+TerminalGrid::Cell TerminalGrid::BlankCell() const {
+    return Cell{' ', pen.fg, pen.bg, static_cast<uint8_t>((pen.attr & (ATTR_DEFAULT_FG | ATTR_DEFAULT_BG)) | mark), 0};
+}
+
+void TerminalGrid::BeginCompose() {
+    ResetAttributes();
+    mark = 0;
+    autowrap = true;
+    std::fill(cells.begin(), cells.end(), BlankCell());
+    cursorRow = cursorCol = 0;
+    savedRow = savedCol = 0;
+    wrapPending = false;
+    state = ParseState::GROUND;
+    utf8Remaining = 0;
+}
+
+void TerminalGrid::EndCompose() {
+    for (int row = 0; row < rows; row++) {
+        auto begin = cells.begin() + row * cols;
+        dirty[row] = fullRedraw || !std::equal(begin, begin + cols, drawn.begin() + row * cols);
+    }
+}
+
+void TerminalGrid::ResetAttributes() {
+    pen = Cell{' ', 0, 0, ATTR_DEFAULT_FG | ATTR_DEFAULT_BG, 0};
+}
+
+void TerminalGrid::SetMark(uint8_t markAttr) {
+    mark = markAttr & (ATTR_MARK | ATTR_MARK_CURRENT);
+}
+
+void TerminalGrid::MoveCursor(int row, int col) {
+    cursorRow = std::clamp(row, 0, rows - 1);
+    cursorCol = std::clamp(col, 0, cols - 1);
+    wrapPending = false;
+}
+
+void TerminalGrid::NewLine() {
+    cursorCol = 0;
+    wrapPending = false;
+    LineFeed();
+}
+
+void TerminalGrid::Put(uint32_t codepoint) {
+    if (wrapPending) {
+        wrapPending = false;
+        if (autowrap) {
+            cursorCol = 0;
+            LineFeed();
+        }
+    }
+
+    Cell& cell = At(cursorRow, cursorCol);
+    cell = pen;
+    cell.codepoint = codepoint;
+    cell.attr |= mark;
+
+    // The cursor parks on the last column until the next character, so a
+    // line of exactly `cols` characters does not leave an empty row
+    if (cursorCol + 1 < cols) {
+        cursorCol++;
+    } else {
+        wrapPending = true;
+    }
+}
+
+void TerminalGrid::LineFeed() {
+    if (cursorRow + 1 < rows) {
+        cursorRow++;
+    } else {
+        ScrollUp();
+    }
+}
+
+void TerminalGrid::ReverseLineFeed() {
+    if (cursorRow > 0) {
+        cursorRow--;
+        return;
+    }
+    std::move_backward(cells.begin(), cells.end() - cols, cells.end());
+    std::fill(cells.begin(), cells.begin() + cols, BlankCell());
+}
+
+void TerminalGrid::ScrollUp() {
+    std::move(cells.begin() + cols, cells.end(), cells.begin());
+    std::fill(cells.end() - cols, cells.end(), BlankCell());
+}
+
+void TerminalGrid::EraseRange(int row, int fromCol, int toCol) {
+    auto begin = cells.begin() + row * cols;
+    std::fill(begin + fromCol, begin + toCol, BlankCell());
+}
+
+void TerminalGrid::EraseDisplay(int mode) {
+    if (mode == 0) {
+        EraseRange(cursorRow, cursorCol, cols);
+        for (int row = cursorRow + 1; row < rows; row++) EraseRange(row, 0, cols);
+    } else if (mode == 1) {
+        for (int row = 0; row < cursorRow; row++) EraseRange(row, 0, cols);
+        EraseRange(cursorRow, 0, cursorCol + 1);
+    } else {
+        for (int row = 0; row < rows; row++) EraseRange(row, 0, cols);
+    }
+}
+
+void TerminalGrid::EraseLine(int mode) {
+    if (mode == 0) {
+        EraseRange(cursorRow, cursorCol, cols);
+    } else if (mode == 1) {
+        EraseRange(cursorRow, 0, cursorCol + 1);
+    } else {
+        EraseRange(cursorRow, 0, cols);
+    }
+}
+
+void TerminalGrid::Feed(std::string_view text) {
+    if (rows == 0) return;
+
+    for (unsigned char byte : text) {
+        if (state == ParseState::GROUND && utf8Remaining > 0) {
+            if ((byte & 0xC0) == 0x80) {
+                utf8Codepoint = (utf8Codepoint << 6) | (byte & 0x3F);
+                if (--utf8Remaining == 0) {
+                    Put(utf8Codepoint);
+                }
+                continue;
+            }
+            // Truncated sequence
+            utf8Remaining = 0;
+            Put('?');
+        }
+
+        switch (state) {
+            case ParseState::GROUND:
+                if (byte == 0x1B) {
+                    state = ParseState::ESCAPE;
+                } else if (byte < 0x20 || byte == 0x7F) {
+                    Execute(byte);
+                } else if (byte < 0x80) {
+                    Put(byte);
+                } else if ((byte & 0xE0) == 0xC0) {
+                    utf8Codepoint = byte & 0x1F;
+                    utf8Remaining = 1;
+                } else if ((byte & 0xF0) == 0xE0) {
+                    utf8Codepoint = byte & 0x0F;
+                    utf8Remaining = 2;
+                } else if ((byte & 0xF8) == 0xF0) {
+                    utf8Codepoint = byte & 0x07;
+                    utf8Remaining = 3;
+                } else {
+                    Put('?');
+                }
+                break;
+
+            case ParseState::ESCAPE:
+                if (byte == '[') {
+                    state = ParseState::CSI;
+                    paramCount = 0;
+                    privateMode = false;
+                } else {
+                    state = ParseState::GROUND;
+                    EscapeDispatch(byte);
+                }
+                break;
+
+            case ParseState::CSI:
+                if (byte >= '0' && byte <= '9') {
+                    if (paramCount == 0) {
+                        params[paramCount++] = -1;
+                    }
+                    int& param = params[paramCount - 1];
+                    param = std::min((param < 0 ? 0 : param) * 10 + (byte - '0'), 9999);
+                } else if (byte == ';') {
+                    if (paramCount == 0) {
+                        params[paramCount++] = -1;
+                    }
+                    if (paramCount < MAX_PARAMS) {
+                        params[paramCount++] = -1;
+                    }
+                } else if (byte == '?') {
+                    privateMode = true;
+                } else if (byte >= 0x40 && byte <= 0x7E) {
+                    state = ParseState::GROUND;
+                    CsiDispatch(byte);
+                } else if (byte == 0x1B) {
+                    state = ParseState::ESCAPE;
+                } else if (byte < 0x20) {
+                    Execute(byte);
+                }
+                // Intermediate bytes are accepted and ignored
+                break;
+        }
+    }
+}
+
+void TerminalGrid::Execute(uint8_t byte) {
+    switch (byte) {
+        case '\r':
+            cursorCol = 0;
+            wrapPending = false;
+            break;
+        case '\n':
+        case '\v':
+        case '\f':
+            wrapPending = false;
+            LineFeed();
+            break;
+        case '\b':
+            if (cursorCol > 0) cursorCol--;
+            wrapPending = false;
+            break;
+        case '\t':
+            cursorCol = std::min(cols - 1, (cursorCol / 8 + 1) * 8);
+            wrapPending = false;
+            break;
+        default:
+            break;
+    }
+}
+
+void TerminalGrid::EscapeDispatch(uint8_t byte) {
+    switch (byte) {
+        case '7':
+            savedRow = cursorRow;
+            savedCol = cursorCol;
+            break;
+        case '8':
+            MoveCursor(savedRow, savedCol);
+            break;
+        case 'D':
+            LineFeed();
+            break;
+        case 'E':
+            NewLine();
+            break;
+        case 'M':
+            ReverseLineFeed();
+            break;
+        case 'c':
+            ResetAttributes();
+            EraseDisplay(2);
+            MoveCursor(0, 0);
+            break;
+        default:
+            break;
+    }
+}
+
+int TerminalGrid::Param(int index, int fallback) const {
+    return (index < paramCount && params[index] > 0) ? params[index] : fallback;
+}
+
+void TerminalGrid::CsiDispatch(uint8_t final) {
+    if (privateMode) {
+        // Only DECAWM (?7h / ?7l) matters here
+        if (final == 'h' || final == 'l') {
+            for (int i = 0; i < paramCount; i++) {
+                if (params[i] == 7) autowrap = (final == 'h');
+            }
+        }
+        return;
+    }
+
+    int count = Param(0, 1);
+    switch (final) {
+        case 'A': MoveCursor(cursorRow - count, cursorCol); break;
+        case 'B': MoveCursor(cursorRow + count, cursorCol); break;
+        case 'C': MoveCursor(cursorRow, cursorCol + count); break;
+        case 'D': MoveCursor(cursorRow, cursorCol - count); break;
+        case 'E': MoveCursor(cursorRow + count, 0); break;
+        case 'F': MoveCursor(cursorRow - count, 0); break;
+        case 'G':
+        case '`': MoveCursor(cursorRow, count - 1); break;
+        case 'd': MoveCursor(count - 1, cursorCol); break;
+        case 'H':
+        case 'f': MoveCursor(Param(0, 1) - 1, Param(1, 1) - 1); break;
+        case 'J': EraseDisplay(Param(0, 0)); break;
+        case 'K': EraseLine(Param(0, 0)); break;
+        case 'm': SelectGraphicRendition(); break;
+        case 's':
+            savedRow = cursorRow;
+            savedCol = cursorCol;
+            break;
+        case 'u': MoveCursor(savedRow, savedCol); break;
+        default: break;
+    }
+}
+
+void TerminalGrid::SelectGraphicRendition() {
+    if (paramCount == 0) {
+        ResetAttributes();
+        return;
+    }
+
+    for (int i = 0; i < paramCount; i++) {
+        int code = params[i] < 0 ? 0 : params[i];
+        if (code == 0) {
+            ResetAttributes();
+        } else if (code == 1) {
+            pen.attr |= ATTR_BOLD;
+        } else if (code == 22) {
+            pen.attr &= ~ATTR_BOLD;
+        } else if (code == 4) {
+            pen.attr |= ATTR_UNDERLINE;
+        } else if (code == 24) {
+            pen.attr &= ~ATTR_UNDERLINE;
+        } else if (code == 7) {
+            pen.attr |= ATTR_INVERSE;
+        } else if (code == 27) {
+            pen.attr &= ~ATTR_INVERSE;
+        } else if (code >= 30 && code <= 37) {
+            pen.fg = static_cast<uint8_t>(code - 30);
+            pen.attr &= ~ATTR_DEFAULT_FG;
+        } else if (code >= 90 && code <= 97) {
+            pen.fg = static_cast<uint8_t>(code - 90 + 8);
+            pen.attr &= ~ATTR_DEFAULT_FG;
+        } else if (code == 39) {
+            pen.attr |= ATTR_DEFAULT_FG;
+        } else if (code >= 40 && code <= 47) {
+            pen.bg = static_cast<uint8_t>(code - 40);
+            pen.attr &= ~ATTR_DEFAULT_BG;
+        } else if (code >= 100 && code <= 107) {
+            pen.bg = static_cast<uint8_t>(code - 100 + 8);
+            pen.attr &= ~ATTR_DEFAULT_BG;
+        } else if (code == 49) {
+            pen.attr |= ATTR_DEFAULT_BG;
+        } else if (code == 38 || code == 48) {
+            // 38;5;n indexed or 38;2;r;g;b truecolor, folded into the 6x6x6 cube
+            int index = -1;
+            if (i + 2 < paramCount && params[i + 1] == 5) {
+                index = std::max(0, params[i + 2]) & 0xFF;
+                i += 2;
+            } else if (i + 4 < paramCount && params[i + 1] == 2) {
+                auto level = [](int value) { return (std::clamp(value, 0, 255) * 5 + 127) / 255; };
+                index = 16 + 36 * level(params[i + 2]) + 6 * level(params[i + 3]) + level(params[i + 4]);
+                i += 4;
+            }
+            if (index < 0) continue;
+            if (code == 38) {
+                pen.fg = static_cast<uint8_t>(index);
+                pen.attr &= ~ATTR_DEFAULT_FG;
+            } else {
+                pen.bg = static_cast<uint8_t>(index);
+                pen.attr &= ~ATTR_DEFAULT_BG;
+            }
+        }
+    }
+}
+
+Color TerminalGrid::PaletteColor(uint8_t index) const {
+    static const Color ansi[16] = {
+        {0, 0, 0, 255},       {205, 0, 0, 255},     {0, 205, 0, 255},     {205, 205, 0, 255},
+        {0, 0, 238, 255},     {205, 0, 205, 255},   {0, 205, 205, 255},   {229, 229, 229, 255},
+        {127, 127, 127, 255}, {255, 0, 0, 255},     {0, 255, 0, 255},     {255, 255, 0, 255},
+        {92, 92, 255, 255},   {255, 0, 255, 255},   {0, 255, 255, 255},   {255, 255, 255, 255}
+    };
+    if (index < 16) return ansi[index];
+
+    if (index < 232) {
+        static const unsigned char levels[6] = {0, 95, 135, 175, 215, 255};
+        int cube = index - 16;
+        return Color{levels[cube / 36], levels[(cube / 6) % 6], levels[cube % 6], 255};
+    }
+
+    unsigned char gray = static_cast<unsigned char>(8 + (index - 232) * 10);
+    return Color{gray, gray, gray, 255};
+}
+
+void TerminalGrid::Render() {
+    if (rows == 0) return;
+
+    if (target.id == 0) {
+        target = LoadRenderTexture(cols * cellWidth, rows * cellHeight);
+        std::fill(dirty.begin(), dirty.end(), 1);
+    }
+
+    if (std::find(dirty.begin(), dirty.end(), 1) == dirty.end()) {
+        return;
+    }
+
+    BeginTextureMode(target);
+    for (int row = 0; row < rows; row++) {
+        if (!dirty[row]) continue;
+        RenderRow(row);
+        std::copy(cells.begin() + row * cols, cells.begin() + (row + 1) * cols, drawn.begin() + row * cols);
+        dirty[row] = 0;
+    }
+    EndTextureMode();
+    fullRedraw = false;
+}
+
+void TerminalGrid::RenderRow(int row) {
+    const Color defaultFg = GREEN;
+    int y = row * cellHeight;
+    const Cell* line = &cells[row * cols];
+
+    BeginScissorMode(0, y, cols * cellWidth, cellHeight);
+    ClearBackground(BLANK);
+
+    // Backgrounds replace the cleared row outright, so translucent marks
+    // keep their alpha when the texture is blended onto the scene
+    BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+    for (int col = 0; col < cols; col++) {
+        const Cell& cell = line[col];
+        Color background = BLANK;
+        if (cell.attr & ATTR_MARK_CURRENT) {
+            background = Color{0, 255, 0, 140};
+        } else if (cell.attr & ATTR_MARK) {
+            background = Color{0, 255, 0, 60};
+        } else if (cell.attr & ATTR_INVERSE) {
+            background = (cell.attr & ATTR_DEFAULT_FG) ? defaultFg : PaletteColor(cell.fg);
+        } else if (!(cell.attr & ATTR_DEFAULT_BG)) {
+            background = PaletteColor(cell.bg);
+        }
+        if (background.a > 0) {
+            DrawRectangle(col * cellWidth, y, cellWidth, cellHeight, background);
+        }
+    }
+    EndBlendMode();
+
+    Font font = GetFontDefault();
+    int glyphY = y + (cellHeight - fontSize) / 2;
+    for (int col = 0; col < cols; col++) {
+        const Cell& cell = line[col];
+        Color foreground = (cell.attr & ATTR_DEFAULT_FG) ? defaultFg : PaletteColor(cell.fg);
+        if (cell.attr & ATTR_INVERSE) {
+            foreground = (cell.attr & ATTR_DEFAULT_BG) ? BLACK : PaletteColor(cell.bg);
+        }
+
+        int x = col * cellWidth;
+        if (cell.attr & ATTR_UNDERLINE) {
+            DrawRectangle(x, y + cellHeight - 2, cellWidth, 1, foreground);
+        }
+        if (cell.codepoint == ' ') continue;
+
+        uint32_t codepoint = cell.codepoint;
+        if (codepoint >= 32 && codepoint <= 126) {
+            x += glyphOffset[codepoint - 32];
+        }
+        DrawTextCodepoint(font, static_cast<int>(codepoint), Vector2{(float)x, (float)glyphY}, (float)fontSize, foreground);
+        if (cell.attr & ATTR_BOLD) {
+            DrawTextCodepoint(font, static_cast<int>(codepoint), Vector2{(float)(x + 1), (float)glyphY}, (float)fontSize, foreground);
+        }
+    }
+
+    EndScissorMode();
+}
+
+void TerminalGrid::Draw(int x, int y) const {
+    if (target.id == 0) return;
+
+    // Render textures are stored bottom-up
+    Rectangle source = {0, 0, (float)target.texture.width, -(float)target.texture.height};
+    DrawTextureRec(target.texture, source, Vector2{(float)x, (float)y}, WHITE);
+}
+
+void TerminalGrid::Unload() {
+    if (target.id != 0) {
+        UnloadRenderTexture(target);
+        target.id = 0;
+    }
+    fullRedraw = true;
+}
@@ -0,0 +1,125 @@
+#pragma once
+#include <raylib.h>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Fixed-size character cell screen for the terminal.
+//
+// Text is fed through a small VT100/ANSI parser (SGR colors and
+// attributes, cursor motion, erase, autowrap) into cols x rows cells.
+// The game recomposes the viewport every frame, which only costs cell
+// writes; rows whose cells differ from what is already in the render
+// texture are marked dirty and Render() redraws just those rows.
+class TerminalGrid {
+public:
+    enum Attr : uint8_t {
+        ATTR_BOLD = 1 << 0,
+        ATTR_UNDERLINE = 1 << 1,
+        ATTR_INVERSE = 1 << 2,
+        ATTR_MARK = 1 << 3,          // Search match or status bar background
+        ATTR_MARK_CURRENT = 1 << 4,  // Current search match
+        ATTR_DEFAULT_FG = 1 << 5,
+        ATTR_DEFAULT_BG = 1 << 6
+    };
+
+    struct Cell {
+        uint32_t codepoint;
+        uint8_t fg;    // xterm 256-color index unless ATTR_DEFAULT_FG
+        uint8_t bg;    // xterm 256-color index unless ATTR_DEFAULT_BG
+        uint8_t attr;
+        uint8_t unused;
+
+        bool operator==(const Cell& other) const {
+            return codepoint == other.codepoint && fg == other.fg && bg == other.bg && attr == other.attr;
+        }
+        bool operator!=(const Cell& other) const { return !(*this == other); }
+    };
+
+private:
+    enum class ParseState { GROUND, ESCAPE, CSI };
+    static const int MAX_PARAMS = 16;
+
+    int cols;
+    int rows;
+    std::vector<Cell> cells;     // Composed this frame
+    std::vector<Cell> drawn;     // What the render texture holds
+    std::vector<uint8_t> dirty;
+
+    // Cursor and pen
+    int cursorRow;
+    int cursorCol;
+    int savedRow;
+    int savedCol;
+    bool wrapPending;
+    bool autowrap;
+    Cell pen;
+    uint8_t mark;
+
+    // Escape sequence parser
+    ParseState state;
+    int params[MAX_PARAMS];
+    int paramCount;
+    bool privateMode;
+    uint32_t utf8Codepoint;
+    int utf8Remaining;
+
+    // Rendering
+    int fontSize;
+    int cellWidth;
+    int cellHeight;
+    uint8_t glyphOffset[95];   // Centers printable ASCII in its cell
+    RenderTexture2D target;
+    bool fullRedraw;
+
+    Cell BlankCell() const;
+    Cell& At(int row, int col) { return cells[row * cols + col]; }
+    void Put(uint32_t codepoint);
+    void LineFeed();
+    void ReverseLineFeed();
+    void ScrollUp();
+    void EraseRange(int row, int fromCol, int toCol);
+    void EraseDisplay(int mode);
+    void EraseLine(int mode);
+    void Execute(uint8_t byte);
+    void EscapeDispatch(uint8_t byte);
+    void CsiDispatch(uint8_t final);
+    void SelectGraphicRendition();
+    int Param(int index, int fallback) const;
+    Color PaletteColor(uint8_t index) const;
+    void RenderRow(int row);
+
+public:
+    TerminalGrid();
+    TerminalGrid(const TerminalGrid&) = delete;
+    TerminalGrid& operator=(const TerminalGrid&) = delete;
+
+    // Resizes and schedules a full redraw when the geometry changes
+    void Configure(int cols, int rows, int fontSize, int cellWidth, int cellHeight);
+    int GetCols() const { return cols; }
+    int GetRows() const { return rows; }
+    int GetCellWidth() const { return cellWidth; }
+    int GetCellHeight() const { return cellHeight; }
+
+    // Composition: BeginCompose() blanks the screen, homes the cursor and
+    // resets the pen; EndCompose() marks rows that differ from the texture
+    void BeginCompose();
+    void Feed(std::string_view text);
+    void NewLine();
+    void ResetAttributes();
+    void SetMark(uint8_t markAttr);
+    void SetAutowrap(bool enabled) { autowrap = enabled; }
+    void MoveCursor(int row, int col);
+    void EraseToEndOfLine() { EraseLine(0); }
+    void EndCompose();
+
+    int GetCursorRow() const { return cursorRow; }
+    int GetCursorCol() const { return cursorCol; }
+    const Cell& GetCell(int row, int col) const { return cells[row * cols + col]; }
+    bool IsRowDirty(int row) const { return dirty[row] != 0; }
+
+    // Redraw dirty rows into the texture; must run outside any texture mode
+    void Render();
+    void Draw(int x, int y) const;
+    void Unload();
+};
@@ -0,0 +1,144 @@
+#include "TerminalScene.h"
+#include "Game.h"
+#include "TerminalCompose.h"
+#include "TextCache.h"
+#include <cmath>
+
+static const char* terminalMusicPath = "music/evasion.mp3";
+
+static const int terminalFontSize = 20;
+
+// Terminal window layout, shared by the grid composer and Draw()
+static const int terminalPadding = 20;
+static const int terminalTextX = 25;
+static const int terminalTextY = 25;
+
+void TerminalScene::DeclareAssets(std::vector<AssetRequest>& assets) const {
+    assets.push_back({AssetType::MUSIC, terminalMusicPath});
+}
+
+void TerminalScene::Enter() {
+    game.PlayMusic(terminalMusicPath, 0.25f);
+    breachRequests = game.View().breachRequests;
+
+    // Keys from the boot screen are dropped with the frame's input
+    game.simulation.ClearInput();
+}
+
+void TerminalScene::Exit() {
+    grid.Unload();
+}
+
+bool TerminalScene::IsAnimating() const {
+    return game.View().pendingWork;
+}
+
+void TerminalScene::Update(float dt) {
+    // Breach requests are counted by the simulation; a new one opens
+    // the minigame
+    if (game.View().breachRequests != breachRequests) {
+        breachRequests = game.View().breachRequests;
+        game.scenes.Push(SceneId::BREACH_LOADING);
+    } else {
+        ForwardInput();
+    }
+
+    // Changed rows are rendered now, before the scene pass begins
+    ComposeGrid();
+    grid.Render();
+}
+
+void TerminalScene::Tick(float step) {
+    cursorTime += step * 4.0f;
+}
+
+void TerminalScene::ForwardInput() {
+    // Everything left this frame belongs to the terminal, in order
+    InputEvent event;
+    while (game.input.Next(event)) {
+        game.simulation.SendInput(event);
+    }
+}
+
+void TerminalScene::Draw() {
+    const SimulationSnapshot& view = game.View();
+    int terminalWidth = game.screenWidth - 2 * terminalPadding;
+    int terminalHeight = game.screenHeight - 2 * terminalPadding;
+
+    // Background and terminal window
+    DrawRectangle(0, 0, game.screenWidth, game.screenHeight, Color{0, 20, 0, 50});
+    DrawRectangleRounded(
+        Rectangle{(float)terminalPadding, (float)terminalPadding,
+                  (float)terminalWidth, (float)terminalHeight},
+        0.1f,
+        20,
+        Color{0, 40, 0, 100}
+    );
+
+    BeginScissorMode(terminalPadding, terminalPadding, terminalWidth, terminalHeight);
+
+    // Scanline, distortion and glitch effects are applied by the CRT pass
+    game.SetCrtArea(Rectangle{(float)terminalPadding, (float)terminalPadding, (float)terminalWidth, (float)terminalHeight},
+                    terminalFontSize, 4, 4, 2);
+
+    // Text was composed into the cell grid before the scene pass
+    grid.Draw(terminalTextX, terminalTextY);
+
+    if (!view.pagerActive) {
+        int cellWidth = grid.GetCellWidth();
+        int cellHeight = grid.GetCellHeight();
+
+        // Cursor sits in the grid cell after the input line
+        if (gridCursorRow >= 0) {
+            if (sin(cursorTime) > -0.2f) {
+                int cursorX = terminalTextX + gridCursorCol * cellWidth;
+                int cursorY = terminalTextY + gridCursorRow * cellHeight;
+                DrawRectangle(cursorX, cursorY + 2,
+                             terminalFontSize / 2, terminalFontSize - 4,
+                             Color{0, 255, 0, static_cast<unsigned char>(200 + sin(cursorTime * 2) * 55)});
+            }
+        }
+
+        TextCache& textCache = TextCache::Instance();
+
+        // Only show UP indicator if we can scroll up
+        if (view.canScrollUp) {
+            textCache.Draw("(UP)", game.screenWidth - terminalPadding - 60, terminalPadding + 10, terminalFontSize, GREEN);
+        } else {
+            textCache.Draw("(UP)", game.screenWidth - terminalPadding - 60, terminalPadding + 10, terminalFontSize, Color{0, 255, 0, 128});
+        }
+
+        // Only show DOWN indicator if we can scroll downxxd
+        if (view.scrollOffset > 0) {
+            textCache.Draw("(DN)", game.screenWidth - terminalPadding - 55, game.screenHeight - terminalPadding - 40, terminalFontSize, GREEN);
+        } else {
+            textCache.Draw("(DN)", game.screenWidth - terminalPadding - 55, game.screenHeight - terminalPadding - 40, terminalFontSize, Color{0, 255, 0, 128});
+        }
+    }
+
+    EndScissorMode();
+
+    if (view.messageVisible) {
+        view.messageDialog.Draw();
+    }
+    if (view.storyVisible) {
+        view.storyDialog.Draw();
+    }
+}
+
+void TerminalScene::ComposeGrid() {
+    int terminalWidth = game.screenWidth - 2 * terminalPadding;
+    int terminalHeight = game.screenHeight - 2 * terminalPadding;
+    int lineSpacing = terminalFontSize + 3;  // Slightly increased line spacing for readability
+    int cellWidth = terminalFontSize * 3 / 5;
+    int rows = (terminalHeight - terminalTextY) / lineSpacing;
+    int cols = (terminalWidth - 2 * (terminalTextX - terminalPadding)) / cellWidth;
+
+    grid.Configure(cols, rows, terminalFontSize, cellWidth, lineSpacing);
+    if (rows != viewRows) {
+        viewRows = rows;
+        game.simulation.SetViewRows(rows);
+    }
+
+    ComposeTerminal(grid, game.View(), gridCursorRow, gridCursorCol);
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <raylib.h>
+#include "Scene.h"
+#include "TerminalGrid.h"
+
+class Game;
+
+// The in-game terminal.
+//
+// The terminal itself runs on the simulation thread: this scene forwards
+// keys to it and draws its latest snapshot. Text is composed into a cell
+// grid each frame (see TerminalCompose.h); only rows that changed are
+// re-rendered. Composition happens in Update(), outside the scene's
+// texture pass, since raylib cannot nest texture modes.
+class TerminalScene : public Scene {
+private:
+    Game& game;
+    TerminalGrid grid;
+    int gridCursorRow = -1;   // -1 when the input line is scrolled out of view
+    int gridCursorCol = 0;
+    int viewRows = -1;         // Row count last sent to the simulation
+    unsigned breachRequests = 0;
+    float cursorTime = 0.0f;
+
+    void ForwardInput();
+    void ComposeGrid();
+
+public:
+    explicit TerminalScene(Game& game) : game(game) {}
+    SceneId GetId() const override { return SceneId::TERMINAL; }
+    void DeclareAssets(std::vector<AssetRequest>& assets) const override;
+    SceneId GetNextScene() const override { return SceneId::BREACH_LOADING; }
+    void Enter() override;
+    void Update(float dt) override;
+    void Tick(float step) override;
+    void Draw() override;
+    void Exit() override;
+    bool IsAnimating() const override;
+};
@@ -0,0 +1,137 @@
+#include "TextCache.h"
+#include "FrameArena.h"
+#include "TextMetrics.h"
+#include <functional>
+
+TextCache::TextCache()
+    : atlas({0}),
+      slots(ROW_COUNT),
+      frame(0) {
+}
+
+TextCache& TextCache::Instance() {
+    static TextCache cache;
+    return cache;
+}
+
+size_t TextCache::Key(std::string_view text, int fontSize) {
+    return std::hash<std::string_view>()(text) ^ (static_cast<size_t>(fontSize) * 0x9e3779b97f4a7c15ull);
+}
+
+int TextCache::Find(std::string_view text, int fontSize, size_t key) const {
+    auto it = lookup.find(key);
+    if (it == lookup.end()) return -1;
+
+    const Slot& slot = slots[it->second];
+    if (slot.fontSize != fontSize || slot.text != text) return -1;
+    return it->second;
+}
+
+int TextCache::Allocate(std::string_view text, int fontSize, size_t key) {
+    // Least recently used row, but never one already drawn this frame
+    int victim = -1;
+    for (int i = 0; i < ROW_COUNT; i++) {
+        if (!slots[i].used) {
+            victim = i;
+            break;
+        }
+        if (slots[i].lastUsed == frame) continue;
+        if (victim < 0 || slots[i].lastUsed < slots[victim].lastUsed) {
+            victim = i;
+        }
+    }
+    if (victim < 0) return -1;
+
+    Slot& slot = slots[victim];
+    if (slot.used) {
+        auto it = lookup.find(slot.key);
+        if (it != lookup.end() && it->second == victim) {
+            lookup.erase(it);
+        }
+    }
+
+    slot.text.assign(text);
+    slot.fontSize = fontSize;
+    slot.width = 0;
+    slot.key = key;
+    slot.lastUsed = frame;
+    slot.used = true;
+    slot.ready = false;
+    lookup[key] = victim;
+    pending.push_back(victim);
+    return victim;
+}
+
+void TextCache::Draw(std::string_view text, int x, int y, int fontSize, Color color) {
+    if (text.empty()) return;
+
+    size_t key = Key(text, fontSize);
+    int index = Find(text, fontSize, key);
+    if (index < 0 && fontSize <= ROW_HEIGHT) {
+        index = Allocate(text, fontSize, key);
+    }
+
+    if (index >= 0) {
+        Slot& slot = slots[index];
+        slot.lastUsed = frame;
+        if (slot.ready) {
+            // Render textures are stored bottom-up
+            Rectangle source = {0, (float)(ATLAS_HEIGHT - (index + 1) * ROW_HEIGHT),
+                                (float)slot.width, -(float)ROW_HEIGHT};
+            DrawTextureRec(atlas.texture, source, Vector2{(float)x, (float)y}, color);
+            return;
+        }
+    }
+
+    // Not rasterized yet (or too tall to cache): draw the glyphs this frame
+    FrameString buffer(text.size());
+    buffer.Append(text);
+    DrawText(buffer.CStr(), x, y, fontSize, color);
+}
+
+void TextCache::Flush() {
+    frame++;
+    if (pending.empty()) return;
+
+    if (atlas.id == 0) {
+        atlas = LoadRenderTexture(ATLAS_WIDTH, ATLAS_HEIGHT);
+        BeginTextureMode(atlas);
+        ClearBackground(BLANK);
+        EndTextureMode();
+    }
+
+    // The default font is 1-bit, so normal alpha blending onto a cleared row
+    // leaves exactly the glyph coverage in the alpha channel
+    BeginTextureMode(atlas);
+    for (int index : pending) {
+        Slot& slot = slots[index];
+        int rowY = index * ROW_HEIGHT;
+
+        slot.width = TextMetrics::Instance().Measure(slot.text, slot.fontSize);
+        if (slot.width > ATLAS_WIDTH) {
+            // Too wide to cache; keep drawing it directly
+            slot.width = 0;
+            continue;
+        }
+
+        BeginScissorMode(0, rowY, ATLAS_WIDTH, ROW_HEIGHT);
+        ClearBackground(BLANK);
+        DrawText(slot.text.c_str(), 0, rowY, slot.fontSize, WHITE);
+        EndScissorMode();
+        slot.ready = true;
+    }
+    EndTextureMode();
+    pending.clear();
+}
+
+void TextCache::Unload() {
+    if (atlas.id != 0) {
+        UnloadRenderTexture(atlas);
+        atlas.id = 0;
+    }
+    for (Slot& slot : slots) {
+        slot = Slot();
+    }
+    lookup.clear();
+    pending.clear();
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <raylib.h>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Cache of rasterized text lines.
+//
+// Each line is drawn once into a row of an atlas render texture and blitted
+// from there on later frames, so static or scrolling text costs one textured
+// quad per line instead of one per glyph. Text is rasterized in white and
+// tinted on draw, so a line is reused regardless of its color.
+//
+// Raylib cannot nest texture modes, so new lines are queued while the scene
+// is drawn (and drawn directly that frame) and rasterized by Flush() before
+// the next scene pass starts.
+class TextCache {
+private:
+    static const int ATLAS_WIDTH = 1024;
+    static const int ATLAS_HEIGHT = 1024;
+    static const int ROW_HEIGHT = 24;
+    static const int ROW_COUNT = ATLAS_HEIGHT / ROW_HEIGHT;
+
+    struct Slot {
+        std::string text;
+        int fontSize = 0;
+        int width = 0;
+        size_t key = 0;
+        uint64_t lastUsed = 0;
+        bool used = false;
+        bool ready = false;    // Rasterized into the atlas
+    };
+
+    RenderTexture2D atlas;
+    std::vector<Slot> slots;
+    std::unordered_map<size_t, int> lookup;  // Key -> slot
+    std::vector<int> pending;
+    uint64_t frame;
+
+    static size_t Key(std::string_view text, int fontSize);
+    int Find(std::string_view text, int fontSize, size_t key) const;
+    int Allocate(std::string_view text, int fontSize, size_t key);
+
+public:
+    TextCache();
+    TextCache(const TextCache&) = delete;
+    TextCache& operator=(const TextCache&) = delete;
+
+    static TextCache& Instance();
+
+    // Same result as DrawText for a single line
+    void Draw(std::string_view text, int x, int y, int fontSize, Color color);
+
+    // Rasterize lines queued since the last call; must run outside any
+    // texture mode, once per frame
+    void Flush();
+
+    // Release the atlas; call before the window closes
+    void Unload();
+};
@@ -0,0 +1,79 @@
+#include "TextLayout.h"
+#include "TextMetrics.h"
+#include <algorithm>
+
+void TextLayout::Build(std::string source, int fontSize, int maxWidth, float height) {
+    text = std::move(source);
+    lineHeight = height;
+    lines.clear();
+
+    TextPrefix prefix;
+    if (maxWidth > 0) {
+        prefix.Build(text, fontSize);
+    }
+
+    auto pushLine = [this](size_t start, size_t end) {
+        float top = lines.size() * lineHeight;
+        lines.push_back(Line{static_cast<uint32_t>(start), static_cast<uint32_t>(end - start), top});
+    };
+
+    // lineEnd is the end of the last word placed on the current line, so
+    // spaces before a wrap point are not drawn or measured
+    size_t lineStart = 0;
+    size_t lineEnd = 0;
+    bool hasWord = false;
+    size_t i = 0;
+    while (i < text.size()) {
+        char c = text[i];
+        if (c == '\n') {
+            pushLine(lineStart, hasWord ? lineEnd : lineStart);
+            lineStart = lineEnd = ++i;
+            hasWord = false;
+            continue;
+        }
+        if (c == ' ') {
+            i++;
+            continue;
+        }
+
+        size_t wordStart = i;
+        while (i < text.size() && text[i] != ' ' && text[i] != '\n') i++;
+
+        // Words wider than the line keep a line of their own
+        if (hasWord && maxWidth > 0 && prefix.Measure(lineStart, i) > maxWidth) {
+            pushLine(lineStart, lineEnd);
+            lineStart = wordStart;
+        }
+        lineEnd = i;
+        hasWord = true;
+    }
+
+    if (hasWord) {
+        pushLine(lineStart, lineEnd);
+    }
+}
+
+void TextLayout::Clear() {
+    text.clear();
+    lines.clear();
+}
+
+std::string_view TextLayout::LineText(size_t index) const {
+    const Line& line = lines[index];
+    return std::string_view(text).substr(line.start, line.length);
+}
+
+size_t TextLayout::FirstLineBelow(float y) const {
+    auto it = std::upper_bound(lines.begin(), lines.end(), y, [this](float value, const Line& line) {
+        return value < line.top + lineHeight;
+    });
+    return it - lines.begin();
+}
+
+size_t TextLayout::LineAtOffset(size_t offset) const {
+    if (lines.empty()) return 0;
+    auto it = std::upper_bound(lines.begin(), lines.end(), offset, [](size_t value, const Line& line) {
+        return value < line.start;
+    });
+    return it == lines.begin() ? 0 : (it - lines.begin()) - 1;
+}
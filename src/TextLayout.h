@@ -0,0 +1,44 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Word-wrapped layout of a block of text in the default font.
+//
+// Build() runs once over the text: one prefix-advance pass, then a greedy
+// wrap that measures each word exactly once against the running line.
+// Lines are stored as offsets into the owned text together with their top
+// edge, so drawing a scrolled view binary-searches the first visible line
+// and touches only the lines on screen.
+class TextLayout {
+public:
+    struct Line {
+        uint32_t start;
+        uint32_t length;
+        float top;
+    };
+
+private:
+    std::string text;
+    std::vector<Line> lines;
+    float lineHeight = 0.0f;
+
+public:
+    // maxWidth <= 0 disables wrapping; '\n' always breaks a line
+    void Build(std::string source, int fontSize, int maxWidth, float lineHeight);
+    void Clear();
+
+    const std::string& GetText() const { return text; }
+    size_t LineCount() const { return lines.size(); }
+    const Line& GetLine(size_t index) const { return lines[index]; }
+    std::string_view LineText(size_t index) const;
+    float GetLineHeight() const { return lineHeight; }
+    float ContentHeight() const { return lines.size() * lineHeight; }
+
+    // First line whose bottom edge is below y
+    size_t FirstLineBelow(float y) const;
+
+    // Line containing byte offset `offset`
+    size_t LineAtOffset(size_t offset) const;
+};
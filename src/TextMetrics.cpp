@@ -0,0 +1,220 @@
+#include "TextMetrics.h"
+#include <algorithm>
+#include <cmath>
+
+// Raylib's default font size and its default text line spacing (the game
+// never calls SetTextLineSpacing)
+static const int defaultFontSize = 10;
+static const int textLineSpacing = 2;
+
+TextMetrics& TextMetrics::Instance() {
+    // One per thread: dialogs are laid out on the simulation thread while
+    // the main thread measures for drawing, and the tables fill lazily
+    thread_local TextMetrics metrics;
+    return metrics;
+}
+
+int TextMetrics::NextCodepoint(const char* text, const char* end, int* byteCount) {
+    // Missing bytes read as 0, which fails the continuation check just as
+    // raylib's read of the terminating NUL does
+    auto at = [&](int i) -> unsigned char {
+        return (text + i < end) ? static_cast<unsigned char>(text[i]) : 0;
+    };
+
+    int codepoint = 0x3f;  // '?'
+    *byteCount = 1;
+    unsigned char lead = at(0);
+
+    if ((lead & 0xf8) == 0xf0) {
+        if (((at(1) & 0xc0) ^ 0x80) || ((at(2) & 0xc0) ^ 0x80) || ((at(3) & 0xc0) ^ 0x80)) return codepoint;
+        codepoint = ((0x07 & lead) << 18) | ((0x3f & at(1)) << 12) | ((0x3f & at(2)) << 6) | (0x3f & at(3));
+        *byteCount = 4;
+    } else if ((lead & 0xf0) == 0xe0) {
+        if (((at(1) & 0xc0) ^ 0x80) || ((at(2) & 0xc0) ^ 0x80)) return codepoint;
+        codepoint = ((0x0f & lead) << 12) | ((0x3f & at(1)) << 6) | (0x3f & at(2));
+        *byteCount = 3;
+    } else if ((lead & 0xe0) == 0xc0) {
+        if ((at(1) & 0xc0) ^ 0x80) return codepoint;
+        codepoint = ((0x1f & lead) << 6) | (0x3f & at(1));
+        *byteCount = 2;
+    } else if ((lead & 0x80) == 0) {
+        codepoint = lead;
+    }
+    return codepoint;
+}
+
+TextMetrics::FontTable& TextMetrics::TableFor(const Font& font) {
+    for (FontTable& table : tables) {
+        if (table.textureId == font.texture.id && table.glyphs == font.glyphs && table.baseSize == font.baseSize) {
+            return table;
+        }
+    }
+
+    tables.emplace_back();
+    FontTable& table = tables.back();
+    table.textureId = font.texture.id;
+    table.glyphs = font.glyphs;
+    table.baseSize = font.baseSize;
+    for (int codepoint = 0; codepoint < 256; codepoint++) {
+        int index = GetGlyphIndex(font, codepoint);
+        const GlyphInfo& glyph = font.glyphs[index];
+        float value = (glyph.advanceX > 0) ? (float)glyph.advanceX : (font.recs[index].width + glyph.offsetX);
+        table.advance[codepoint] = value;
+        table.intAdvance[codepoint] = static_cast<int>(value);
+        if (value != std::floor(value)) {
+            table.integral = false;
+        }
+    }
+    return table;
+}
+
+float TextMetrics::Advance(FontTable& table, const Font& font, int codepoint) {
+    if (codepoint >= 0 && codepoint < 256) {
+        return table.advance[codepoint];
+    }
+
+    auto it = table.extended.find(codepoint);
+    if (it != table.extended.end()) {
+        return it->second;
+    }
+
+    int index = GetGlyphIndex(font, codepoint);
+    const GlyphInfo& glyph = font.glyphs[index];
+    float value = (glyph.advanceX > 0) ? (float)glyph.advanceX : (font.recs[index].width + glyph.offsetX);
+    table.extended[codepoint] = value;
+    return value;
+}
+
+int TextMetrics::Measure(std::string_view text, int fontSize) {
+    Font font = GetFontDefault();
+    if (font.texture.id == 0) return 0;
+
+    if (fontSize < defaultFontSize) fontSize = defaultFontSize;
+    int spacing = fontSize / defaultFontSize;
+    return static_cast<int>(MeasureEx(font, text, (float)fontSize, (float)spacing).x);
+}
+
+Vector2 TextMetrics::MeasureEx(const Font& font, std::string_view text, float fontSize, float spacing) {
+    Vector2 textSize = {0, 0};
+
+    // Raylib stops at the first NUL
+    size_t length = text.find('\0');
+    if (length == std::string_view::npos) length = text.size();
+    if (font.texture.id == 0 || length == 0) return textSize;
+
+    FontTable& table = TableFor(font);
+    const char* data = text.data();
+    const char* end = data + length;
+
+    float textWidth = 0.0f;
+    float maxWidth = 0.0f;
+    float textHeight = fontSize;
+    int count = 0;
+    int maxCount = 0;
+
+    const char* p = data;
+    while (p < end) {
+        unsigned char c = static_cast<unsigned char>(*p);
+
+        if (c < 0x80 && c != '\n') {
+            // ASCII run: whole-number advances are summed as ints with four
+            // independent accumulators, which is exact and vectorizes
+            const char* run = p;
+            while (p < end && static_cast<unsigned char>(*p) < 0x80 && *p != '\n') p++;
+            size_t n = p - run;
+
+            if (table.integral) {
+                int sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+                size_t i = 0;
+                for (; i + 4 <= n; i += 4) {
+                    sum0 += table.intAdvance[static_cast<unsigned char>(run[i])];
+                    sum1 += table.intAdvance[static_cast<unsigned char>(run[i + 1])];
+                    sum2 += table.intAdvance[static_cast<unsigned char>(run[i + 2])];
+                    sum3 += table.intAdvance[static_cast<unsigned char>(run[i + 3])];
+                }
+                for (; i < n; i++) {
+                    sum0 += table.intAdvance[static_cast<unsigned char>(run[i])];
+                }
+                textWidth += (float)(sum0 + sum1 + sum2 + sum3);
+            } else {
+                // Keep raylib's summation order so rounding matches
+                for (size_t i = 0; i < n; i++) {
+                    textWidth += table.advance[static_cast<unsigned char>(run[i])];
+                }
+            }
+
+            count += static_cast<int>(n);
+            if (maxCount < count) maxCount = count;
+            continue;
+        }
+
+        int byteCount = 0;
+        int codepoint = NextCodepoint(p, end, &byteCount);
+        p += byteCount;
+
+        if (codepoint != '\n') {
+            textWidth += Advance(table, font, codepoint);
+            count++;
+        } else {
+            if (maxWidth < textWidth) maxWidth = textWidth;
+            count = 0;
+            textWidth = 0;
+            textHeight += (fontSize + textLineSpacing);
+        }
+        if (maxCount < count) maxCount = count;
+    }
+
+    if (maxWidth < textWidth) maxWidth = textWidth;
+
+    float scaleFactor = fontSize / (float)font.baseSize;
+    textSize.x = maxWidth * scaleFactor + (float)((maxCount - 1) * spacing);
+    textSize.y = textHeight;
+    return textSize;
+}
+
+void TextPrefix::Build(std::string_view text, int size) {
+    Font font = GetFontDefault();
+    if (size < defaultFontSize) size = defaultFontSize;
+    fontSize = (float)size;
+    spacing = (float)(size / defaultFontSize);
+    scaleFactor = (font.baseSize > 0) ? fontSize / (float)font.baseSize : 1.0f;
+
+    advance.assign(text.size() + 1, 0.0f);
+    count.assign(text.size() + 1, 0);
+    if (font.texture.id == 0) return;
+
+    TextMetrics& metrics = TextMetrics::Instance();
+    TextMetrics::FontTable& table = metrics.TableFor(font);
+
+    const char* data = text.data();
+    const char* end = data + text.size();
+    size_t i = 0;
+    while (i < text.size()) {
+        int byteCount = 0;
+        int codepoint = TextMetrics::NextCodepoint(data + i, end, &byteCount);
+        float glyph = (codepoint == '\n') ? 0.0f : metrics.Advance(table, font, codepoint);
+        int glyphs = (codepoint == '\n') ? 0 : 1;
+
+        // Offsets inside a multi-byte codepoint share the value before it
+        for (int b = 1; b < byteCount && i + b <= text.size(); b++) {
+            advance[i + b] = advance[i];
+            count[i + b] = count[i];
+        }
+        size_t next = std::min(text.size(), i + byteCount);
+        advance[next] = advance[i] + glyph;
+        count[next] = count[i] + glyphs;
+        i = next;
+    }
+}
+
+int TextPrefix::Measure(size_t begin, size_t end) const {
+    end = std::min(end, advance.size() - 1);
+    if (end <= begin) return 0;
+
+    int glyphs = count[end] - count[begin];
+    if (glyphs == 0) return 0;
+
+    // Whole-number advances make the difference exact, as in MeasureText
+    float width = advance[end] - advance[begin];
+    return static_cast<int>(width * scaleFactor + (float)((glyphs - 1) * spacing));
+}
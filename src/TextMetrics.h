@@ -0,0 +1,66 @@
+#pragma once
+#include <raylib.h>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Drop-in replacements for MeasureText / MeasureTextEx.
+//
+// Glyph advances are looked up once per font into a flat table indexed by
+// codepoint (Latin-1 range; others are cached on first use), so measuring
+// is a table sum with no glyph search. Results match raylib exactly: the
+// same UTF-8 decoding, fallback glyph, multi-line rules and float math.
+class TextMetrics {
+private:
+    struct FontTable {
+        unsigned int textureId = 0;
+        const GlyphInfo* glyphs = nullptr;
+        int baseSize = 0;
+        bool integral = true;      // All advances are whole numbers
+        float advance[256] = {};
+        int intAdvance[256] = {};
+        std::unordered_map<int, float> extended;
+    };
+
+    std::vector<FontTable> tables;
+
+    FontTable& TableFor(const Font& font);
+    float Advance(FontTable& table, const Font& font, int codepoint);
+
+public:
+    static TextMetrics& Instance();   // Per thread
+
+    // Same as raylib's MeasureText (default font, spacing fontSize/10)
+    int Measure(std::string_view text, int fontSize);
+
+    // Same as raylib's MeasureTextEx
+    Vector2 MeasureEx(const Font& font, std::string_view text, float fontSize, float spacing);
+
+    // Forget cached tables, e.g. after a font is unloaded
+    void Clear() { tables.clear(); }
+
+    // Decodes like raylib's GetCodepointNext, without reading past `end`
+    static int NextCodepoint(const char* text, const char* end, int* byteCount);
+
+    friend class TextPrefix;
+};
+
+// Cumulative advances along one line of text, for measuring many
+// substrings of it (e.g. candidate lines while word wrapping).
+// Newlines are not measured; ranges should not span them.
+class TextPrefix {
+private:
+    std::vector<float> advance;   // Sum of advances before each byte offset
+    std::vector<int> count;       // Codepoints before each byte offset
+    float scaleFactor = 1.0f;
+    float spacing = 0.0f;
+    float fontSize = 0.0f;
+
+public:
+    // Default font at fontSize, as MeasureText would use it
+    void Build(std::string_view text, int fontSize);
+
+    // Same as Measure(text.substr(begin, end - begin), fontSize); offsets
+    // must fall on codepoint boundaries
+    int Measure(size_t begin, size_t end) const;
+};
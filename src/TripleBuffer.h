@@ -0,0 +1,41 @@
+#pragma once
+#include <atomic>
+
+// Lock-free triple buffer: one writer publishes whole values, one reader
+// always gets the newest one published. Neither side ever waits; the
+// writer may publish faster or slower than the reader consumes, and
+// values in between are simply skipped.
+//
+// The writer fills Back() completely (it holds stale data from two
+// publishes ago) and calls Publish(). The reader calls Acquire() and then
+// reads Front(), which stays untouched until its next Acquire().
+template <typename T>
+class TripleBuffer {
+private:
+    static const int INDEX_MASK = 3;
+    static const int FRESH = 4;   // Middle slot holds an unread value
+
+    T slots[3];
+    std::atomic<int> middle{1};
+    int back = 0;    // Writer only
+    int front = 2;   // Reader only
+
+public:
+    // Writer thread only
+    T& Back() { return slots[back]; }
+    void Publish() {
+        int previous = middle.exchange(back | FRESH, std::memory_order_acq_rel);
+        back = previous & INDEX_MASK;
+    }
+
+    // Reader thread only; false (and Front() unchanged) if nothing new
+    bool Acquire() {
+        if (!(middle.load(std::memory_order_acquire) & FRESH)) {
+            return false;
+        }
+        int previous = middle.exchange(front, std::memory_order_acq_rel);
+        front = previous & INDEX_MASK;
+        return true;
+    }
+    T& Front() { return slots[front]; }
+};
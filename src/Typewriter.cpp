@@ -0,0 +1,103 @@
+#include "Typewriter.h"
+#include "FrameArena.h"
+#include "TextCache.h"
+#include <algorithm>
+
+void Typewriter::Start(std::string text, int size, int maxWidth, float lineHeight,
+                       float speed, float pause) {
+    fontSize = size;
+    layout.Build(std::move(text), fontSize, maxWidth, lineHeight);
+    charsPerSecond = speed;
+    linePause = pause;
+    revealed = 0;
+    cursorLine = 0;
+    pending = 0.0f;
+    pauseLeft = 0.0f;
+    if (charsPerSecond <= 0.0f) {
+        RevealAll();
+    }
+}
+
+void Typewriter::Clear() {
+    layout.Clear();
+    revealed = 0;
+    cursorLine = 0;
+    pending = 0.0f;
+    pauseLeft = 0.0f;
+}
+
+void Typewriter::AdvanceCursorLine() {
+    while (cursorLine + 1 < layout.LineCount() && revealed >= layout.GetLine(cursorLine + 1).start) {
+        cursorLine++;
+    }
+}
+
+int Typewriter::Update(float deltaTime) {
+    if (IsDone()) return 0;
+
+    const std::string& text = layout.GetText();
+    int typed = 0;
+
+    if (pauseLeft > 0.0f) {
+        pauseLeft -= deltaTime;
+        if (pauseLeft > 0.0f) return 0;
+        deltaTime = -pauseLeft;
+        pauseLeft = 0.0f;
+    }
+
+    pending += deltaTime * charsPerSecond;
+    while (pending >= 1.0f && revealed < text.size()) {
+        char c = text[revealed++];
+        pending -= 1.0f;
+
+        // Continuation bytes of a UTF-8 sequence are not separate keystrokes
+        while (revealed < text.size() && (static_cast<unsigned char>(text[revealed]) & 0xC0) == 0x80) {
+            revealed++;
+        }
+
+        if (c != ' ' && c != '\n') {
+            typed++;
+        }
+        if (c == '\n' && linePause > 0.0f) {
+            pauseLeft = linePause;
+            pending = 0.0f;
+            break;
+        }
+    }
+
+    AdvanceCursorLine();
+    return typed;
+}
+
+void Typewriter::RevealAll() {
+    revealed = layout.GetText().size();
+    pending = 0.0f;
+    pauseLeft = 0.0f;
+    AdvanceCursorLine();
+}
+
+size_t Typewriter::VisibleLineCount() const {
+    if (layout.LineCount() == 0) return 0;
+    return IsDone() ? layout.LineCount() : cursorLine + 1;
+}
+
+void Typewriter::Draw(int x, int y, float scroll, float viewHeight, Color color) const {
+    TextCache& textCache = TextCache::Instance();
+
+    size_t lineCount = VisibleLineCount();
+    for (size_t i = layout.FirstLineBelow(scroll); i < lineCount; i++) {
+        const TextLayout::Line& line = layout.GetLine(i);
+        float top = line.top - scroll;
+        if (top >= viewHeight) break;
+
+        int lineY = y + static_cast<int>(top);
+        if (revealed >= line.start + line.length) {
+            textCache.Draw(layout.LineText(i), x, lineY, fontSize, color);
+        } else if (revealed > line.start) {
+            // Line being typed changes every character; skip the cache
+            FrameString partial(revealed - line.start);
+            partial.Append(std::string_view(layout.GetText()).substr(line.start, revealed - line.start));
+            DrawText(partial.CStr(), x, lineY, fontSize, color);
+        }
+    }
+}
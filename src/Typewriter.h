@@ -0,0 +1,49 @@
+#pragma once
+#include <raylib.h>
+#include <string>
+#include "TextLayout.h"
+
+// Reveals a block of text one character at a time.
+//
+// The text is laid out once up front. Revealing only moves a byte cursor
+// and, when it crosses a line start, the current line index, so each
+// frame's work is proportional to the characters revealed, not to the
+// text length. Drawing touches only lines inside the view: finished lines
+// come from the text cache and only the line being typed is drawn glyph
+// by glyph.
+class Typewriter {
+private:
+    TextLayout layout;
+    size_t revealed = 0;        // Bytes of text shown
+    size_t cursorLine = 0;      // Line containing the reveal cursor
+    float charsPerSecond = 0.0f;
+    float linePause = 0.0f;     // Extra delay after each '\n'
+    float pending = 0.0f;       // Fractional characters owed
+    float pauseLeft = 0.0f;
+    int fontSize = 20;
+
+    void AdvanceCursorLine();
+
+public:
+    // charsPerSecond <= 0 shows everything at once
+    void Start(std::string text, int fontSize, int maxWidth, float lineHeight,
+               float charsPerSecond, float linePause = 0.0f);
+    void Clear();
+
+    // Reveal by elapsed time; returns the number of non-blank characters
+    // revealed (for typing sounds)
+    int Update(float deltaTime);
+    void RevealAll();
+
+    bool IsDone() const { return revealed >= layout.GetText().size(); }
+    bool IsEmpty() const { return layout.GetText().empty(); }
+    size_t GetRevealed() const { return revealed; }
+
+    // Lines that have at least one revealed character (or are complete)
+    size_t VisibleLineCount() const;
+    size_t GetCursorLine() const { return cursorLine; }
+    const TextLayout& GetLayout() const { return layout; }
+
+    // Draw lines intersecting [scroll, scroll + viewHeight) at (x, y)
+    void Draw(int x, int y, float scroll, float viewHeight, Color color) const;
+};
@@ -0,0 +1,178 @@
+#include "VoicePool.h"
+
+VoicePool::VoicePool(int maxVoices, int voicesPerSample)
+    : maxVoices(maxVoices), voicesPerSample(voicesPerSample) {
+    for (float& volume : busVolume) {
+        volume = 1.0f;
+    }
+}
+
+VoicePool::~VoicePool() {
+    Unload();
+}
+
+int VoicePool::SampleFor(const Sound& sound) {
+    for (size_t i = 0; i < samples.size(); i++) {
+        if (samples[i].source == &sound) {
+            return (int)i;
+        }
+    }
+
+    // First play of this sample: its aliases share the source's data
+    Sample sample;
+    sample.source = &sound;
+    for (int i = 0; i < voicesPerSample; i++) {
+        Voice voice;
+        voice.alias = LoadSoundAlias(sound);
+        voice.sample = (int)samples.size();
+        sample.voices.push_back((int)voices.size());
+        voices.push_back(voice);
+    }
+    samples.push_back(sample);
+    return (int)samples.size() - 1;
+}
+
+int VoicePool::RefreshActive() {
+    int active = 0;
+    for (Voice& voice : voices) {
+        if (voice.active && !IsSoundPlaying(voice.alias)) {
+            voice.active = false;
+        }
+        if (voice.active) {
+            active++;
+        }
+    }
+    return active;
+}
+
+int VoicePool::FindVictim(int sample, SoundPriority priority) const {
+    int victim = -1;
+    for (int index = 0; index < (int)voices.size(); index++) {
+        const Voice& voice = voices[index];
+        if (!voice.active || voice.priority > priority || (sample >= 0 && voice.sample != sample)) {
+            continue;
+        }
+        if (victim < 0 || voice.priority < voices[victim].priority ||
+            (voice.priority == voices[victim].priority && voice.started < voices[victim].started)) {
+            victim = index;
+        }
+    }
+    return victim;
+}
+
+void VoicePool::Start(int index, SoundBus bus, SoundPriority priority, float volume) {
+    Voice& voice = voices[index];
+    voice.bus = bus;
+    voice.priority = priority;
+    voice.volume = volume;
+    voice.started = ++playCount;
+    voice.active = true;
+    SetSoundVolume(voice.alias, volume * busVolume[(int)bus]);
+    PlaySound(voice.alias);
+}
+
+bool VoicePool::Play(const Sound& sound, SoundBus bus, SoundPriority priority, float volume) {
+    int active = RefreshActive();
+    int sampleIndex = SampleFor(sound);
+    const Sample& sample = samples[sampleIndex];
+
+    int free = -1;
+    for (int index : sample.voices) {
+        if (!voices[index].active) {
+            free = index;
+            break;
+        }
+    }
+
+    if (free < 0) {
+        // All of this sample's voices are busy: restart its least important
+        int victim = FindVictim(sampleIndex, priority);
+        if (victim < 0) {
+            return false;
+        }
+        StopSound(voices[victim].alias);
+        Start(victim, bus, priority, volume);
+        return true;
+    }
+
+    if (active >= maxVoices) {
+        // Pool is full: make room by stopping any less important voice
+        int victim = FindVictim(-1, priority);
+        if (victim < 0) {
+            return false;
+        }
+        StopSound(voices[victim].alias);
+        voices[victim].active = false;
+    }
+
+    Start(free, bus, priority, volume);
+    return true;
+}
+
+void VoicePool::SetBusVolume(SoundBus bus, float volume) {
+    busVolume[(int)bus] = volume;
+    for (Voice& voice : voices) {
+        if (voice.bus == bus) {
+            SetSoundVolume(voice.alias, voice.volume * volume);
+        }
+    }
+}
+
+int VoicePool::GetActiveVoiceCount() {
+    return RefreshActive();
+}
+
+void VoicePool::StopAll() {
+    for (Voice& voice : voices) {
+        if (voice.active) {
+            StopSound(voice.alias);
+            voice.active = false;
+        }
+    }
+}
+
+void VoicePool::Forget(const Sound& sound) {
+    int forgotten = -1;
+    for (size_t i = 0; i < samples.size(); i++) {
+        if (samples[i].source == &sound) {
+            forgotten = (int)i;
+            break;
+        }
+    }
+    if (forgotten < 0) {
+        return;
+    }
+
+    // Drop its voices and renumber the ones that stay
+    std::vector<Voice> kept;
+    for (Voice& voice : voices) {
+        if (voice.sample == forgotten) {
+            if (voice.active) {
+                StopSound(voice.alias);
+            }
+            UnloadSoundAlias(voice.alias);
+            continue;
+        }
+        if (voice.sample > forgotten) {
+            voice.sample--;
+        }
+        kept.push_back(voice);
+    }
+    voices = kept;
+    samples.erase(samples.begin() + forgotten);
+    for (Sample& sample : samples) {
+        sample.voices.clear();
+    }
+    for (int index = 0; index < (int)voices.size(); index++) {
+        samples[voices[index].sample].voices.push_back(index);
+    }
+}
+
+void VoicePool::Unload() {
+    StopAll();
+    for (Voice& voice : voices) {
+        UnloadSoundAlias(voice.alias);
+    }
+    voices.clear();
+    samples.clear();
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include <raylib.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Volume buses a sound plays through
+enum class SoundBus {
+    TYPING,     // Typewriter clicks
+    UI,         // Button presses
+    EFFECTS,    // Machine sounds and cutscene cues
+    COUNT
+};
+
+// Which voice gives way when the pool is full
+enum class SoundPriority {
+    LOW,
+    NORMAL,
+    HIGH
+};
+
+// Plays sound effects on a fixed set of voices.
+//
+// Each sample gets a few aliases (LoadSoundAlias: same sample data, own
+// playback state), so a sound that is still playing is layered over
+// instead of restarted. At most maxVoices play at once. When a new sound
+// finds no voice, the lowest-priority, oldest playing voice is stolen; a
+// sound never steals from a higher priority and is dropped instead.
+//
+// Samples stay owned by AssetLoader and are keyed by the Sound's address;
+// Forget() must run before one is unloaded (AssetLoader's sound unload
+// handler does this), or its aliases would outlive the sample data and a
+// later sound at the same address would pick them up.
+class VoicePool {
+private:
+    struct Sample {
+        const Sound* source = nullptr;
+        std::vector<int> voices;   // Indices into `voices`
+    };
+
+    struct Voice {
+        Sound alias = {0};
+        int sample = -1;
+        SoundBus bus = SoundBus::EFFECTS;
+        SoundPriority priority = SoundPriority::LOW;
+        float volume = 1.0f;
+        uint64_t started = 0;   // Play order, for picking the oldest
+        bool active = false;    // Started and not yet seen finished
+    };
+
+    int maxVoices;
+    int voicesPerSample;
+    std::vector<Sample> samples;
+    std::vector<Voice> voices;
+    float busVolume[(int)SoundBus::COUNT];
+    uint64_t playCount = 0;
+
+    int SampleFor(const Sound& sound);
+    int RefreshActive();
+    int FindVictim(int sample, SoundPriority priority) const;   // Any sample if < 0
+    void Start(int voice, SoundBus bus, SoundPriority priority, float volume);
+
+public:
+    explicit VoicePool(int maxVoices = 12, int voicesPerSample = 4);
+    ~VoicePool();
+    VoicePool(const VoicePool&) = delete;
+    VoicePool& operator=(const VoicePool&) = delete;
+
+    // False if every voice is busy with more important sounds
+    bool Play(const Sound& sound, SoundBus bus, SoundPriority priority, float volume = 1.0f);
+
+    // Also applies to voices already playing on the bus
+    void SetBusVolume(SoundBus bus, float volume);
+    float GetBusVolume(SoundBus bus) const { return busVolume[(int)bus]; }
+
+    int GetActiveVoiceCount();
+    void StopAll();
+
+    // Stop and release the aliases of a sample that is about to be unloaded
+    void Forget(const Sound& sound);
+
+    // Release every alias; call before the samples and audio device go
+    void Unload();
+};
@@ -1,8 +1,29 @@
 #include "Game.h"
+#include <cstdio>
+#include <cstring>
+
+// terminal_infiltrator [WIDTHxHEIGHT] [--fit]
+// WIDTHxHEIGHT is the internal resolution the game draws at (800x450 by
+// default); --fit fills the window smoothly instead of by whole multiples
+int main(int argc, char** argv) {
+  int width = 800;
+  int height = 450;
+  bool integerScaling = true;
+  for (int i = 1; i < argc; i++) {
+    int w = 0;
+    int h = 0;
+    if (strcmp(argv[i], "--fit") == 0) {
+      integerScaling = false;
+    } else if (sscanf(argv[i], "%dx%d", &w, &h) == 2 && w >= 320 && h >= 180) {
+      width = w;
+      height = h;
+    } else {
+      fprintf(stderr, "Ignoring argument '%s'\n", argv[i]);
+    }
+  }
 
-int main() {
   InitAudioDevice();
-  Game game(800, 450);
+  Game game(width, height, integerScaling);
   game.Run();
   CloseAudioDevice();
   return 0;
@@ -0,0 +1,48 @@
+#version 100
+
+// CRT post-processing for one scene frame (GLSL ES 1.0 for web builds).
+// Mirrors glsl330/crt.fs.
+
+precision mediump float;
+
+varying vec2 fragTexCoord;
+varying vec4 fragColor;
+
+uniform sampler2D texture0;
+uniform vec4 colDiffuse;
+
+uniform vec2 resolution;
+uniform vec4 effectRect;
+uniform float time;
+uniform float scanlineSpacing;
+uniform float scanlineIntensity;
+uniform float darkLineSpacing;
+uniform float distortionSpacing;
+uniform float glitch;
+uniform vec3 greenTint;
+
+void main()
+{
+    vec4 color = texture2D(texture0, fragTexCoord)*colDiffuse*fragColor;
+
+    vec2 pixel = floor(vec2(fragTexCoord.x, 1.0 - fragTexCoord.y)*resolution);
+    vec2 local = pixel - effectRect.xy;
+
+    if ((local.x >= 0.0) && (local.y >= 0.0) && (local.x < effectRect.z) && (local.y < effectRect.w))
+    {
+        if (mod(local.y - floor(time*30.0), scanlineSpacing) < 2.0) color.rgb = mix(color.rgb, greenTint, 0.04*scanlineIntensity);
+
+        if ((darkLineSpacing > 0.0) && (mod(local.y, darkLineSpacing) < 1.0)) color.rgb = mix(color.rgb, vec3(0.0), 0.08*scanlineIntensity);
+
+        if ((distortionSpacing > 0.0) && (mod(local.y, distortionSpacing) < 1.0))
+        {
+            float sway = sin(time*2.0 + pixel.y*0.1)*2.0;
+            float offset = sign(sway)*floor(abs(sway));
+            if ((local.x >= offset) && (local.x < effectRect.z + offset)) color.rgb = mix(color.rgb, greenTint, 0.02*scanlineIntensity);
+        }
+
+        color.rgb = mix(color.rgb, greenTint, 0.02*glitch);
+    }
+
+    gl_FragColor = color;
+}
@@ -0,0 +1,53 @@
+#version 330
+
+// CRT post-processing for one scene frame.
+// Replaces the per-row DrawRectangle scanline, distortion and glitch passes.
+
+in vec2 fragTexCoord;
+in vec4 fragColor;
+
+uniform sampler2D texture0;
+uniform vec4 colDiffuse;
+
+uniform vec2 resolution;          // Scene target size in pixels
+uniform vec4 effectRect;          // x, y, width, height (top-left origin); zero size disables
+uniform float time;
+uniform float scanlineSpacing;    // Distance between rolling bright bands
+uniform float scanlineIntensity;  // Strength multiplier for all line effects
+uniform float darkLineSpacing;    // Spacing of dark CRT rows, 0 disables
+uniform float distortionSpacing;  // Spacing of wobbling tint rows, 0 disables
+uniform float glitch;             // 1.0 on frames with a glitch flash
+uniform vec3 greenTint;
+
+out vec4 finalColor;
+
+void main()
+{
+    vec4 color = texture(texture0, fragTexCoord)*colDiffuse*fragColor;
+
+    // Render textures are stored bottom-up. Rows and columns are whole
+    // pixels, as the rectangles this replaces covered them.
+    vec2 pixel = floor(vec2(fragTexCoord.x, 1.0 - fragTexCoord.y)*resolution);
+    vec2 local = pixel - effectRect.xy;
+
+    if ((local.x >= 0.0) && (local.y >= 0.0) && (local.x < effectRect.z) && (local.y < effectRect.w))
+    {
+        // Rolling 2 px bright band, moving down at 30 px/s
+        if (mod(local.y - floor(time*30.0), scanlineSpacing) < 2.0) color.rgb = mix(color.rgb, greenTint, 0.04*scanlineIntensity);
+
+        // Static dark rows
+        if ((darkLineSpacing > 0.0) && (mod(local.y, darkLineSpacing) < 1.0)) color.rgb = mix(color.rgb, vec3(0.0), 0.08*scanlineIntensity);
+
+        // Tint rows that sway sideways over time
+        if ((distortionSpacing > 0.0) && (mod(local.y, distortionSpacing) < 1.0))
+        {
+            // Truncated like the integer rectangle position it replaces
+            float offset = trunc(sin(time*2.0 + pixel.y*0.1)*2.0);
+            if ((local.x >= offset) && (local.x < effectRect.z + offset)) color.rgb = mix(color.rgb, greenTint, 0.02*scanlineIntensity);
+        }
+
+        color.rgb = mix(color.rgb, greenTint, 0.02*glitch);
+    }
+
+    finalColor = color;
+}
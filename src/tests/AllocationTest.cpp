@@ -0,0 +1,154 @@
+#include <raylib.h>
+#include <cstdio>
+#include <string>
+#include "BreachProtocol.h"
+#include "FrameArena.h"
+#include "Simulation.h"
+#include "TerminalCompose.h"
+#include "TerminalGrid.h"
+#include "TextCache.h"
+#include "TextMetrics.h"
+#include "Typewriter.h"
+
+// Draws the per-frame text paths (FrameString, TextCache, Typewriter, the
+// terminal grid and the breach board) in a hidden window and fails if a
+// warmed-up frame touches the heap.
+// Built only with COUNT_ALLOCATIONS; needs a display (Xvfb works).
+
+static const int WARMUP_FRAMES = 10;
+static const int MEASURED_FRAMES = 120;
+
+static int failures = 0;
+
+static void Expect(const char* name, unsigned long long allocations) {
+    if (allocations != 0) {
+        fprintf(stderr, "FAIL %s: %llu heap allocations over %d frames\n", name, allocations, MEASURED_FRAMES);
+        failures++;
+    } else {
+        printf("ok   %s\n", name);
+    }
+}
+
+// Runs warm-up frames, then returns the allocations made by the measured ones
+template <typename DrawFrame>
+static unsigned long long CountFrames(DrawFrame drawFrame) {
+    unsigned long long before = 0;
+    for (int frame = 0; frame < WARMUP_FRAMES + MEASURED_FRAMES; frame++) {
+        if (frame == WARMUP_FRAMES) {
+            before = AllocationCounter::ThreadCount();
+        }
+        TextCache::Instance().Flush();
+        BeginDrawing();
+        ClearBackground(BLACK);
+        drawFrame(frame);
+        EndDrawing();
+        FrameArena::Instance().Reset();
+    }
+    return AllocationCounter::ThreadCount() - before;
+}
+
+int main() {
+    if (!AllocationCounter::IsEnabled()) {
+        fprintf(stderr, "Built without COUNT_ALLOCATIONS\n");
+        return 1;
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(800, 450, "allocation test");
+
+    // Status lines assembled each frame, growing past their first guess
+    Expect("FrameString", CountFrames([](int frame) {
+        FrameString status(8);
+        status.Append("frame ").AppendInt(frame).Append(" of ").AppendInt(MEASURED_FRAMES);
+        for (int i = 0; i < 200; i++) {
+            status.Append('.');
+        }
+        DrawText(status.CStr(), 10, 10, 20, GREEN);
+    }));
+
+    // BreachLoadingScene::Draw: a FrameString centred on a measured label
+    Expect("Loading text", CountFrames([](int frame) {
+        const char* loadingText = "LOADING BREACH PROTOCOL";
+        FrameString text;
+        text.Append(loadingText).Append('.', frame % 4);
+        DrawText(text.CStr(), 400 - TextMetrics::Instance().Measure(loadingText, 30) / 2, 225, 30, GREEN);
+    }));
+
+    // Scrollback-style lines: cached in the warm-up, blitted afterwards
+    std::string lines[20];
+    for (int i = 0; i < 20; i++) {
+        lines[i] = "drwxr-xr-x  agent  " + std::to_string(i * 4096) + "  archive_" + std::to_string(i);
+    }
+    Expect("TextCache", CountFrames([&lines](int) {
+        for (int i = 0; i < 20; i++) {
+            TextCache::Instance().Draw(lines[i], 10, 10 + i * 20, 20, GREEN);
+        }
+    }));
+
+    // A finished block of text plus one line still being typed
+    Typewriter finished;
+    finished.Start("INCOMING TRANSMISSION\nSource: unknown\nEncryption: none\n\nStand by.",
+                   20, 760, 24.0f, 0.0f);
+    Typewriter typing;
+    typing.Start(std::string(400, 'x'), 20, 100000, 24.0f, 60.0f);
+    Expect("Typewriter", CountFrames([&](int) {
+        typing.Update(1.0f / 60.0f);
+        finished.Draw(10, 10, 0.0f, 450.0f, GREEN);
+        typing.Draw(10, 200, 0.0f, 240.0f, GREEN);
+    }));
+
+    // Terminal snapshots as the simulation publishes them: scrollback with
+    // search marks, the same scrolled up, and a pager page. Alternating
+    // them every frame keeps rows dirty, so Render() redraws each time.
+    SimulationSnapshot scrollback;
+    for (int i = 0; i < 17; i++) {
+        scrollback.lines.push_back("\x1b[1mlog_" + std::to_string(i) + ".txt\x1b[0m  access denied  " + std::to_string(i * 512));
+        scrollback.marks.push_back(i % 5 == 0 ? SimulationSnapshot::MARK_MATCH : SimulationSnapshot::MARK_NONE);
+    }
+    scrollback.marks[15] = SimulationSnapshot::MARK_CURRENT;
+    scrollback.searchQuery = "denied";
+    scrollback.inputLine = "agent@mainframe:/var/log$ grep denied";
+    scrollback.messageVisible = true;
+    scrollback.messageDialog.Show("CONNECTION ESTABLISHED\n\nThe archive is yours. Read it before they notice.");
+
+    SimulationSnapshot scrolled;
+    scrolled.lines = scrollback.lines;
+    scrolled.marks.assign(scrolled.lines.size(), SimulationSnapshot::MARK_NONE);
+    scrolled.scrollOffset = 3;
+    scrolled.canScrollUp = true;
+
+    SimulationSnapshot pager;
+    pager.pagerActive = true;
+    for (int i = 0; i < 16; i++) {
+        pager.pagerLines.push_back("entry " + std::to_string(i) + ": " + std::string(120, 'a' + i));
+    }
+    pager.pagerStatus = "manifest.txt lines 1-16/240 6%";
+
+    const SimulationSnapshot* views[] = {&scrollback, &scrolled, &pager};
+    TerminalGrid grid;
+    grid.Configure(62, 17, 20, 12, 23);
+    Expect("TerminalGrid", CountFrames([&](int frame) {
+        const SimulationSnapshot& view = *views[frame % 3];
+        int cursorRow = -1;
+        int cursorCol = 0;
+        ComposeTerminal(grid, view, cursorRow, cursorCol);
+        grid.Render();
+        grid.Draw(25, 25);
+        if (view.messageVisible) {
+            view.messageDialog.Draw();
+        }
+    }));
+    grid.Unload();
+
+    // The breach board with its countdown running and one code picked
+    BreachProtocol board(800, 450);
+    board.click(Vector2{250, 60});   // Top left cell
+    Expect("Breach board", CountFrames([&board](int frame) {
+        board.draw(10.0f - frame / 60.0f);
+    }));
+
+    TextCache::Instance().Unload();
+    CloseWindow();
+    return failures == 0 ? 0 : 1;
+}
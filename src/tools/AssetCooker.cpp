@@ -0,0 +1,115 @@
+// Converts one resource into a format that is cheaper to decode.
+//
+//   asset_cooker <input> <output>
+//
+// The output extension picks the conversion: .qoi for images, .qoa for
+// compressed audio. Each run times decoding the input and the result, so
+// the build log doubles as a before/after benchmark, and the output is
+// only kept when it decodes faster than the input. Otherwise it is
+// deleted and resource_packer keeps the original. Runs without a window
+// or audio device; only raylib's file loaders and exporters are used.
+
+#include <raylib.h>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+
+enum CookResult {
+    COOK_FAILED,
+    COOK_KEPT,        // Output written, it decodes faster
+    COOK_SKIPPED      // Input decodes as fast or faster, output removed
+};
+
+// Best of a few runs, in milliseconds
+static double TimeDecode(const std::function<void()>& decode) {
+    double best = 0.0;
+    for (int run = 0; run < 3; run++) {
+        auto start = std::chrono::steady_clock::now();
+        decode();
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (run == 0 || ms < best) best = ms;
+    }
+    return best;
+}
+
+static CookResult Decide(const char* output, double before, double after) {
+    if (after < before) {
+        return COOK_KEPT;
+    }
+    remove(output);
+    printf("asset_cooker: %s is not cheaper to decode, keeping the original\n", GetFileName(output));
+    return COOK_SKIPPED;
+}
+
+static CookResult CookImage(const char* input, const char* output) {
+    Image image = LoadImage(input);
+    if (!image.data) {
+        return COOK_FAILED;
+    }
+    bool exported = ExportImage(image, output);
+    UnloadImage(image);
+    if (!exported) {
+        return COOK_FAILED;
+    }
+
+    double before = TimeDecode([&] { UnloadImage(LoadImage(input)); });
+    double after = TimeDecode([&] { UnloadImage(LoadImage(output)); });
+    printf("asset_cooker: %s %d B, decode %.2f ms -> %s %d B, decode %.2f ms\n",
+           GetFileName(input), GetFileLength(input), before,
+           GetFileName(output), GetFileLength(output), after);
+    return Decide(output, before, after);
+}
+
+static CookResult CookAudio(const char* input, const char* output) {
+    Wave wave = LoadWave(input);
+    if (!wave.data) {
+        return COOK_FAILED;
+    }
+    // QOA takes 16-bit samples; MP3 decodes to float
+    WaveFormat(&wave, wave.sampleRate, 16, wave.channels);
+    double seconds = (double)wave.frameCount / wave.sampleRate;
+    bool exported = ExportWave(wave, output);
+    UnloadWave(wave);
+    if (!exported || seconds <= 0.0) {
+        return COOK_FAILED;
+    }
+
+    // Whole-file decodes, given per second of audio so tracks compare.
+    // Streaming decodes in buffer-sized pieces with its own per-call
+    // overhead, so this is decoder throughput, not a per-frame cost.
+    double before = TimeDecode([&] { UnloadWave(LoadWave(input)); });
+    double after = TimeDecode([&] { UnloadWave(LoadWave(output)); });
+    printf("asset_cooker: %s %d B, decode %.2f ms (%.3f ms per audio second) -> %s %d B, decode %.2f ms (%.3f ms per audio second)\n",
+           GetFileName(input), GetFileLength(input), before, before / seconds,
+           GetFileName(output), GetFileLength(output), after, after / seconds);
+    return Decide(output, before, after);
+}
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        fprintf(stderr, "usage: %s <input> <output>\n", argv[0]);
+        return 1;
+    }
+    const char* input = argv[1];
+    const char* output = argv[2];
+    SetTraceLogLevel(LOG_WARNING);
+
+    // A stale output from an earlier cook must not outlive a skip or failure
+    remove(output);
+
+    CookResult cooked = COOK_FAILED;
+    if (IsFileExtension(output, ".qoi")) {
+        cooked = CookImage(input, output);
+    } else if (IsFileExtension(output, ".qoa")) {
+        cooked = CookAudio(input, output);
+    } else {
+        fprintf(stderr, "asset_cooker: no conversion to %s\n", GetFileExtension(output));
+        return 1;
+    }
+
+    if (cooked == COOK_FAILED) {
+        fprintf(stderr, "asset_cooker: failed to cook %s\n", input);
+        return 1;
+    }
+    return 0;
+}
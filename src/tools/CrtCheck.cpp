@@ -0,0 +1,193 @@
+// Renders the terminal's CRT look both ways and compares the frames.
+//
+//   crt_check <resources dir> [output dir]
+//
+// The reference is the old per-row DrawRectangle pass (rolling band,
+// dark rows, swaying tint rows) drawn over a terminal-like scene; the
+// candidate is the same scene run through shaders/glsl330/crt.fs the way
+// Game::DrawCrtPass does. Exits non-zero if too many pixels differ. With
+// an output directory the reference, candidate and difference images are
+// written there. The old bands also spilled a few rows and columns past
+// the terminal area; the shader stops at its edge, so those pixels are
+// expected to differ.
+//
+// Needs a GL 3.3 context; headless it runs under Xvfb with llvmpipe:
+//   LIBGL_ALWAYS_SOFTWARE=1 xvfb-run ./crt_check ../src/resources
+
+#include <raylib.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+static const int WIDTH = 800;
+static const int HEIGHT = 450;
+
+// TerminalScene's layout and CRT settings
+static const int PADDING = 20;
+static const float SCANLINE_SPACING = 20.0f;
+static const float DARK_LINE_SPACING = 4.0f;
+static const float DISTORTION_SPACING = 4.0f;
+
+// Channel difference still counted as a match: the old pass blended with
+// 8-bit alpha (10/255), the shader mixes with 0.04
+static const int TOLERANCE = 2;
+static const double MAX_MISMATCH = 0.005;
+
+static void DrawScene() {
+    int areaWidth = WIDTH - 2 * PADDING;
+    int areaHeight = HEIGHT - 2 * PADDING;
+    ClearBackground(BLACK);
+    DrawRectangle(0, 0, WIDTH, HEIGHT, Color{0, 20, 0, 50});
+    DrawRectangle(PADDING, PADDING, areaWidth, areaHeight, Color{0, 40, 0, 100});
+
+    // Blocks standing in for lines of text, so the effects land on both
+    // lit and dark pixels
+    for (int row = 0; row < areaHeight / 20; row++) {
+        int x = PADDING + 10;
+        for (int word = 0; word < 12; word++) {
+            int length = 12 + ((row * 7 + word * 13) % 9) * 6;
+            if (x + length > PADDING + areaWidth - 10) break;
+            DrawRectangle(x, PADDING + 10 + row * 20, length, 14, GREEN);
+            x += length + 10;
+        }
+    }
+}
+
+// The passes crt.fs replaced, as TerminalScene drew them
+static void DrawRectangleCrt(float time) {
+    int areaWidth = WIDTH - 2 * PADDING;
+    int areaHeight = HEIGHT - 2 * PADDING;
+
+    float scanlineOffset = std::fmod(time * 30.0f, SCANLINE_SPACING);
+    for (int y = PADDING; y < PADDING + areaHeight; y += (int)SCANLINE_SPACING) {
+        int adjustedY = y + (int)scanlineOffset;
+        DrawRectangle(PADDING, adjustedY, areaWidth, 2, Color{0, 255, 0, 10});
+    }
+    for (int y = PADDING; y < PADDING + areaHeight; y += (int)DARK_LINE_SPACING) {
+        DrawRectangle(PADDING, y, areaWidth, 1, Color{0, 0, 0, 20});
+        float offset = std::sin(time * 2.0f + y * 0.1f) * 2.0f;
+        DrawRectangle(PADDING + (int)offset, y, areaWidth, 1, Color{0, 255, 0, 5});
+    }
+}
+
+static void DrawShaderCrt(Shader shader, const RenderTexture2D& scene, float time) {
+    float scanlineIntensity = 1.0f;
+    float greenTint[3] = {0.0f, 1.0f, 0.0f};
+    float resolution[2] = {(float)WIDTH, (float)HEIGHT};
+    float effectRect[4] = {(float)PADDING, (float)PADDING, (float)(WIDTH - 2 * PADDING), (float)(HEIGHT - 2 * PADDING)};
+    float scanlineSpacing = SCANLINE_SPACING;
+    float darkLineSpacing = DARK_LINE_SPACING;
+    float distortionSpacing = DISTORTION_SPACING;
+    float glitch = 0.0f;
+    SetShaderValue(shader, GetShaderLocation(shader, "scanlineIntensity"), &scanlineIntensity, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(shader, GetShaderLocation(shader, "greenTint"), greenTint, SHADER_UNIFORM_VEC3);
+    SetShaderValue(shader, GetShaderLocation(shader, "resolution"), resolution, SHADER_UNIFORM_VEC2);
+    SetShaderValue(shader, GetShaderLocation(shader, "effectRect"), effectRect, SHADER_UNIFORM_VEC4);
+    SetShaderValue(shader, GetShaderLocation(shader, "time"), &time, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(shader, GetShaderLocation(shader, "scanlineSpacing"), &scanlineSpacing, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(shader, GetShaderLocation(shader, "darkLineSpacing"), &darkLineSpacing, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(shader, GetShaderLocation(shader, "distortionSpacing"), &distortionSpacing, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(shader, GetShaderLocation(shader, "glitch"), &glitch, SHADER_UNIFORM_FLOAT);
+
+    // Render textures are flipped vertically; blending as DrawCrtPass does
+    Rectangle source = {0, 0, (float)WIDTH, -(float)HEIGHT};
+    BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+    BeginShaderMode(shader);
+    DrawTexturePro(scene.texture, source, Rectangle{0, 0, (float)WIDTH, (float)HEIGHT}, Vector2{0, 0}, 0.0f, WHITE);
+    EndShaderMode();
+    EndBlendMode();
+}
+
+// Pixels whose largest channel difference exceeds TOLERANCE; the largest
+// difference seen goes to maxDifference. Writes a difference mask to diff.
+static int CountMismatches(const Image& expected, const Image& actual, Image& diff, int* maxDifference) {
+    const Color* a = static_cast<const Color*>(expected.data);
+    const Color* b = static_cast<const Color*>(actual.data);
+    Color* d = static_cast<Color*>(diff.data);
+    int mismatches = 0;
+    *maxDifference = 0;
+    for (int i = 0; i < expected.width * expected.height; i++) {
+        int difference = std::abs(a[i].r - b[i].r);
+        difference = std::max(difference, std::abs(a[i].g - b[i].g));
+        difference = std::max(difference, std::abs(a[i].b - b[i].b));
+        *maxDifference = std::max(*maxDifference, difference);
+        bool mismatch = difference > TOLERANCE;
+        mismatches += mismatch ? 1 : 0;
+        d[i] = mismatch ? RED : Color{(unsigned char)(difference * 60), 0, 0, 255};
+    }
+    return mismatches;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: crt_check <resources dir> [output dir]\n");
+        return 1;
+    }
+    std::string resources = argv[1];
+    const char* outputDir = argc > 2 ? argv[2] : nullptr;
+
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(WIDTH, HEIGHT, "crt check");
+
+    Shader shader = LoadShader(nullptr, (resources + "/shaders/glsl330/crt.fs").c_str());
+    if (!IsShaderValid(shader)) {
+        fprintf(stderr, "crt.fs failed to compile or link\n");
+        CloseWindow();
+        return 1;
+    }
+
+    RenderTexture2D scene = LoadRenderTexture(WIDTH, HEIGHT);
+    RenderTexture2D reference = LoadRenderTexture(WIDTH, HEIGHT);
+    RenderTexture2D candidate = LoadRenderTexture(WIDTH, HEIGHT);
+
+    // A few times, so the band sits at whole and fractional offsets and
+    // the sway is caught on both sides
+    const float times[] = {0.0f, 0.37f, 1.23f, 4.9f};
+    bool passed = true;
+    int frame = 0;
+    for (float time : times) {
+        BeginTextureMode(reference);
+        DrawScene();
+        DrawRectangleCrt(time);
+        EndTextureMode();
+
+        BeginTextureMode(scene);
+        DrawScene();
+        EndTextureMode();
+        BeginTextureMode(candidate);
+        ClearBackground(BLACK);
+        DrawShaderCrt(shader, scene, time);
+        EndTextureMode();
+
+        Image expected = LoadImageFromTexture(reference.texture);
+        Image actual = LoadImageFromTexture(candidate.texture);
+        Image diff = ImageCopy(expected);
+        int maxDifference = 0;
+        int mismatches = CountMismatches(expected, actual, diff, &maxDifference);
+        double fraction = (double)mismatches / (WIDTH * HEIGHT);
+        bool ok = fraction <= MAX_MISMATCH;
+        passed = passed && ok;
+        printf("%s t=%.2fs: %d of %d pixels differ by more than %d (%.3f%%), max difference %d\n",
+               ok ? "ok  " : "FAIL", time, mismatches, WIDTH * HEIGHT, TOLERANCE, fraction * 100.0, maxDifference);
+
+        if (outputDir) {
+            ExportImage(expected, TextFormat("%s/crt_reference_%d.png", outputDir, frame));
+            ExportImage(actual, TextFormat("%s/crt_shader_%d.png", outputDir, frame));
+            ExportImage(diff, TextFormat("%s/crt_diff_%d.png", outputDir, frame));
+        }
+        UnloadImage(expected);
+        UnloadImage(actual);
+        UnloadImage(diff);
+        frame++;
+    }
+
+    UnloadRenderTexture(scene);
+    UnloadRenderTexture(reference);
+    UnloadRenderTexture(candidate);
+    UnloadShader(shader);
+    CloseWindow();
+    return passed ? 0 : 1;
+}
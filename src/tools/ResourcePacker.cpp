@@ -0,0 +1,198 @@
+// Builds resources.pak from one or more resource directories.
+//
+//   resource_packer <output file> [--exclude <name>]...
+//                   [--replace <name> <cooked name>]... <dir>...
+//
+// Every regular file is stored under its path relative to its directory,
+// with '/' separators; the same name in two directories is an error. The
+// build passes resources/ and the asset cooker's output directory. It
+// excludes files nothing loads, and names each cookable source with
+// --replace: the source is left out when its cooked variant was written
+// (the runtime then only opens the cooked name) and kept when the cooker
+// found the original cheaper. See ResourcePack.h for the layout.
+
+#include "../ResourcePack.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+struct PackedFile {
+    std::string name;
+    fs::path source;
+    uint64_t size = 0;
+};
+
+static uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+static bool CopyInto(std::ofstream& out, const fs::path& source, uint64_t size) {
+    std::ifstream in(source, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+    std::vector<char> buffer(1 << 16);
+    uint64_t remaining = size;
+    while (remaining > 0) {
+        size_t chunk = (size_t)std::min<uint64_t>(remaining, buffer.size());
+        if (!in.read(buffer.data(), chunk)) {
+            return false;
+        }
+        out.write(buffer.data(), chunk);
+        remaining -= chunk;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s <output file> [--exclude <name>]... [--replace <name> <cooked name>]... <dir>...\n", argv[0]);
+        return 1;
+    }
+    fs::path output = argv[1];
+
+    std::vector<std::string> excluded;
+    std::vector<std::pair<std::string, std::string>> replaced;
+    int arg = 2;
+    while (arg < argc) {
+        if (arg + 1 < argc && strcmp(argv[arg], "--exclude") == 0) {
+            excluded.push_back(argv[arg + 1]);
+            arg += 2;
+        } else if (arg + 2 < argc && strcmp(argv[arg], "--replace") == 0) {
+            replaced.emplace_back(argv[arg + 1], argv[arg + 2]);
+            arg += 3;
+        } else {
+            break;
+        }
+    }
+    if (arg >= argc) {
+        fprintf(stderr, "usage: %s <output file> [--exclude <name>]... [--replace <name> <cooked name>]... <dir>...\n", argv[0]);
+        return 1;
+    }
+
+    std::error_code error;
+    std::vector<PackedFile> files;
+    size_t excludedCount = 0;
+    uint64_t excludedSize = 0;
+    for (; arg < argc; arg++) {
+        fs::path root = argv[arg];
+        for (fs::recursive_directory_iterator it(root, error), end; !error && it != end; it.increment(error)) {
+            if (!it->is_regular_file()) {
+                continue;
+            }
+            PackedFile file;
+            file.name = it->path().lexically_relative(root).generic_string();
+            file.source = it->path();
+            file.size = it->file_size();
+            if (std::find(excluded.begin(), excluded.end(), file.name) != excluded.end()) {
+                excludedCount++;
+                excludedSize += file.size;
+                continue;
+            }
+            files.push_back(file);
+        }
+        if (error) {
+            fprintf(stderr, "resource_packer: cannot read %s: %s\n", root.string().c_str(), error.message().c_str());
+            return 1;
+        }
+    }
+
+    // A source whose cooked variant exists is never opened
+    size_t replacedCount = 0;
+    for (const auto& pair : replaced) {
+        auto named = [](const std::string& name) {
+            return [&name](const PackedFile& file) { return file.name == name; };
+        };
+        if (std::none_of(files.begin(), files.end(), named(pair.second))) {
+            continue;
+        }
+        auto source = std::find_if(files.begin(), files.end(), named(pair.first));
+        if (source != files.end()) {
+            excludedCount++;
+            excludedSize += source->size;
+            replacedCount++;
+            files.erase(source);
+        }
+    }
+
+    // The runtime binary-searches the index by name
+    std::sort(files.begin(), files.end(), [](const PackedFile& a, const PackedFile& b) {
+        return a.name < b.name;
+    });
+    for (size_t i = 1; i < files.size(); i++) {
+        if (files[i].name == files[i - 1].name) {
+            fprintf(stderr, "resource_packer: %s is in more than one directory\n", files[i].name.c_str());
+            return 1;
+        }
+    }
+
+    PackHeader header = {};
+    memcpy(header.magic, PACK_MAGIC, sizeof(PACK_MAGIC));
+    header.version = PACK_VERSION;
+    header.entryCount = (uint32_t)files.size();
+    header.indexOffset = sizeof(PackHeader);
+
+    std::vector<PackEntry> index(files.size());
+    std::string names;
+    for (size_t i = 0; i < files.size(); i++) {
+        index[i].nameOffset = (uint32_t)names.size();
+        index[i].nameLength = (uint32_t)files[i].name.size();
+        names += files[i].name;
+    }
+    header.nameTableOffset = header.indexOffset + index.size() * sizeof(PackEntry);
+    header.nameTableSize = (uint32_t)names.size();
+
+    uint64_t offset = header.nameTableOffset + header.nameTableSize;
+    for (size_t i = 0; i < files.size(); i++) {
+        offset = AlignUp(offset, PACK_ALIGNMENT);
+        index[i].dataOffset = offset;
+        index[i].dataSize = files[i].size;
+        offset += files[i].size + 1;   // Trailing zero byte
+    }
+
+    fs::path temporary = output;
+    temporary += ".tmp";
+    std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        fprintf(stderr, "resource_packer: cannot write %s\n", temporary.string().c_str());
+        return 1;
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(PackEntry));
+    out.write(names.data(), names.size());
+
+    uint64_t written = header.nameTableOffset + header.nameTableSize;
+    const char zeros[PACK_ALIGNMENT] = {};
+    for (size_t i = 0; i < files.size(); i++) {
+        out.write(zeros, index[i].dataOffset - written);
+        if (!CopyInto(out, files[i].source, files[i].size)) {
+            fprintf(stderr, "resource_packer: cannot read %s\n", files[i].source.string().c_str());
+            return 1;
+        }
+        out.write(zeros, 1);
+        written = index[i].dataOffset + files[i].size + 1;
+    }
+    out.close();
+    if (!out) {
+        fprintf(stderr, "resource_packer: write to %s failed\n", temporary.string().c_str());
+        return 1;
+    }
+
+    // Replace the old pack only once the new one is complete
+    fs::rename(temporary, output, error);
+    if (error) {
+        fprintf(stderr, "resource_packer: cannot replace %s: %s\n", output.string().c_str(), error.message().c_str());
+        return 1;
+    }
+    printf("resource_packer: %zu files, %llu bytes -> %s (%zu excluded, %zu of them cooked, %llu bytes)\n", files.size(),
+           (unsigned long long)written, output.string().c_str(), excludedCount, replacedCount,
+           (unsigned long long)excludedSize);
+    return 0;
+}